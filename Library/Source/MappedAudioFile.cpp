@@ -0,0 +1,408 @@
+/*
+  ==============================================================================
+
+    MappedAudioFile.cpp
+    Created: 19 Oct 2026 11:48:05pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "MappedAudioFile.h"
+#include "../../Source/ShitKernels.h"
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_BSD
+ #include <sys/mman.h>
+ #include <unistd.h>
+ #define MAPPEDAUDIOFILE_HAS_MADVISE 1
+#else
+ #define MAPPEDAUDIOFILE_HAS_MADVISE 0
+#endif
+
+namespace
+{
+    // =============================================================================
+    bool hasId(const juce::uint8* bytes, const char* id)
+    {
+        return std::memcmp(bytes, id, 4) == 0;
+    }
+
+    double bigEndianDouble(const juce::uint8* bytes)
+    {
+        auto bits = juce::ByteOrder::bigEndianInt64(bytes);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // WAV format tags
+    constexpr int wavePcm = 1;
+    constexpr int waveFloat = 3;
+    constexpr int waveExtensible = 0xfffe;
+
+    // CAF linear PCM flags
+    constexpr juce::uint32 cafIsFloat = 1;
+    constexpr juce::uint32 cafIsLittleEndian = 2;
+
+    // Header sizes of the files createForWriting() makes, both keep the
+    // samples 4 byte aligned
+    constexpr int wavHeaderBytes = 56;
+    constexpr int cafHeaderBytes = 68;
+}
+
+// =============================================================================
+std::unique_ptr<MappedAudioFile> MappedAudioFile::openForReading(const juce::File& file,
+                                                                    juce::String& errorMessage)
+{
+    std::unique_ptr<MappedAudioFile> result(new MappedAudioFile());
+    result->mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    if (result->mapping->getData() == nullptr)
+    {
+        errorMessage = "can't map " + file.getFullPathName();
+        return {};
+    }
+
+    auto* bytes = static_cast<const juce::uint8*>(result->mapping->getData());
+    auto size = result->mapping->getSize();
+
+    auto parsed = size >= 12 && hasId(bytes, "RIFF") && hasId(bytes + 8, "WAVE") ? result->parseWav(errorMessage)
+                : size >= 8 && hasId(bytes, "caff")                                 ? result->parseCaf(errorMessage)
+                : false;
+
+    if (!parsed)
+    {
+        if (errorMessage.isEmpty())
+            errorMessage = file.getFullPathName() + " isn't a WAV or CAF file";
+
+        return {};
+    }
+
+    return result;
+}
+
+bool MappedAudioFile::parseWav(juce::String& errorMessage)
+{
+    auto* bytes = static_cast<juce::uint8*>(mapping->getData());
+    auto size = mapping->getSize();
+
+    int formatTag = 0, bitsPerSample = 0;
+    bool hasFormat = false;
+
+    // Walk the chunks, padded to even lengths
+    for (size_t position = 12; position + 8 <= size;)
+    {
+        auto* chunk = bytes + position;
+        auto chunkBytes = (size_t) juce::ByteOrder::littleEndianInt(chunk + 4);
+        auto* body = chunk + 8;
+        auto bodyBytes = juce::jmin(chunkBytes, size - position - 8);
+
+        if (hasId(chunk, "fmt ") && bodyBytes >= 16)
+        {
+            formatTag = juce::ByteOrder::littleEndianShort(body);
+            numChannels = juce::ByteOrder::littleEndianShort(body + 2);
+            sampleRate = (double) juce::ByteOrder::littleEndianInt(body + 4);
+            bitsPerSample = juce::ByteOrder::littleEndianShort(body + 14);
+
+            // the real tag is the start of the sub format GUID
+            if (formatTag == waveExtensible && bodyBytes >= 40)
+                formatTag = juce::ByteOrder::littleEndianShort(body + 24);
+
+            hasFormat = true;
+        }
+        else if (hasId(chunk, "data"))
+        {
+            sampleData = body;
+            sampleDataBytes = bodyBytes;
+        }
+
+        position += 8 + chunkBytes + (chunkBytes & 1);
+    }
+
+    if (!hasFormat || sampleData == nullptr || numChannels <= 0)
+    {
+        errorMessage = "WAV file without a format or data chunk";
+        return false;
+    }
+
+    if (formatTag == waveFloat && bitsPerSample == 32)
+        format = SampleFormat::float32;
+    else if (formatTag == wavePcm && bitsPerSample == 24)
+        format = SampleFormat::int24;
+    else
+    {
+        errorMessage = "only 32 bit float and 24 bit PCM WAV files can be mapped";
+        return false;
+    }
+
+    isBigEndian = false;
+    bytesPerSample = bitsPerSample / 8;
+    bytesPerFrame = bytesPerSample * numChannels;
+    lengthInFrames = (juce::int64) (sampleDataBytes / (size_t) bytesPerFrame);
+
+    return true;
+}
+
+bool MappedAudioFile::parseCaf(juce::String& errorMessage)
+{
+    auto* bytes = static_cast<juce::uint8*>(mapping->getData());
+    auto size = mapping->getSize();
+
+    juce::uint32 formatFlags = 0, bytesPerPacket = 0, framesPerPacket = 0, bitsPerChannel = 0;
+    bool isLinearPcm = false, hasFormat = false;
+
+    for (size_t position = 8; position + 12 <= size;)
+    {
+        auto* chunk = bytes + position;
+        auto chunkBytes = (juce::int64) juce::ByteOrder::bigEndianInt64(chunk + 4);
+        auto* body = chunk + 12;
+        auto bytesLeft = size - position - 12;
+
+        if (hasId(chunk, "desc") && bytesLeft >= 32)
+        {
+            sampleRate = bigEndianDouble(body);
+            isLinearPcm = hasId(body + 8, "lpcm");
+            formatFlags = juce::ByteOrder::bigEndianInt(body + 12);
+            bytesPerPacket = juce::ByteOrder::bigEndianInt(body + 16);
+            framesPerPacket = juce::ByteOrder::bigEndianInt(body + 20);
+            numChannels = (int) juce::ByteOrder::bigEndianInt(body + 24);
+            bitsPerChannel = juce::ByteOrder::bigEndianInt(body + 28);
+            hasFormat = true;
+        }
+        else if (hasId(chunk, "data") && bytesLeft >= 4)
+        {
+            // after a 4 byte edit count. A size of -1 runs to the end of the file.
+            sampleData = body + 4;
+            sampleDataBytes = chunkBytes < 4 ? bytesLeft - 4
+                                             : juce::jmin((size_t) chunkBytes - 4, bytesLeft - 4);
+        }
+
+        if (chunkBytes < 0)
+            break;
+
+        position += 12 + (size_t) chunkBytes;
+    }
+
+    if (!hasFormat || sampleData == nullptr || numChannels <= 0)
+    {
+        errorMessage = "CAF file without a format or data chunk";
+        return false;
+    }
+
+    auto isFloat = (formatFlags & cafIsFloat) != 0;
+    auto isPacked = framesPerPacket == 1 && bytesPerPacket == (juce::uint32) numChannels * bitsPerChannel / 8;
+
+    if (isLinearPcm && isPacked && isFloat && bitsPerChannel == 32)
+        format = SampleFormat::float32;
+    else if (isLinearPcm && isPacked && !isFloat && bitsPerChannel == 24)
+        format = SampleFormat::int24;
+    else
+    {
+        errorMessage = "only 32 bit float and 24 bit linear PCM CAF files can be mapped";
+        return false;
+    }
+
+    isBigEndian = (formatFlags & cafIsLittleEndian) == 0;
+    bytesPerSample = (int) bitsPerChannel / 8;
+    bytesPerFrame = bytesPerSample * numChannels;
+    lengthInFrames = (juce::int64) (sampleDataBytes / (size_t) bytesPerFrame);
+
+    return true;
+}
+
+// =============================================================================
+std::unique_ptr<MappedAudioFile> MappedAudioFile::createForWriting(const juce::File& file,
+                                                                    const double sampleRate,
+                                                                    const int numChannels,
+                                                                    const juce::int64 numFrames,
+                                                                    juce::String& errorMessage)
+{
+    const auto isCaf = file.hasFileExtension("caf");
+    const auto dataBytes = (juce::int64) numFrames * numChannels * (juce::int64) sizeof(float);
+    const auto headerBytes = isCaf ? cafHeaderBytes : wavHeaderBytes;
+
+    if (!isCaf && dataBytes + headerBytes - 8 > (juce::int64) 0xffffffff)
+    {
+        errorMessage = "too long for a WAV file, write a CAF instead";
+        return {};
+    }
+
+    // The header, then the file stretched to its final size for mapping
+    {
+        file.deleteFile();
+        juce::FileOutputStream stream(file);
+
+        if (stream.failedToOpen())
+        {
+            errorMessage = "can't create " + file.getFullPathName();
+            return {};
+        }
+
+        if (isCaf)
+        {
+            stream.write("caff", 4);
+            stream.writeShortBigEndian(1);      // version
+            stream.writeShortBigEndian(0);      // flags
+
+            stream.write("desc", 4);
+            stream.writeInt64BigEndian(32);
+            stream.writeDoubleBigEndian(sampleRate);
+            stream.write("lpcm", 4);
+            stream.writeIntBigEndian((int) (cafIsFloat | cafIsLittleEndian));
+            stream.writeIntBigEndian(numChannels * (int) sizeof(float));
+            stream.writeIntBigEndian(1);
+            stream.writeIntBigEndian(numChannels);
+            stream.writeIntBigEndian(32);
+
+            stream.write("data", 4);
+            stream.writeInt64BigEndian(dataBytes + 4);
+            stream.writeIntBigEndian(0);        // edit count
+        }
+        else
+        {
+            stream.write("RIFF", 4);
+            stream.writeInt((int) (dataBytes + headerBytes - 8));
+            stream.write("WAVE", 4);
+
+            stream.write("fmt ", 4);
+            stream.writeInt(16);
+            stream.writeShort((short) waveFloat);
+            stream.writeShort((short) numChannels);
+            stream.writeInt((int) sampleRate);
+            stream.writeInt((int) sampleRate * numChannels * (int) sizeof(float));
+            stream.writeShort((short) (numChannels * (int) sizeof(float)));
+            stream.writeShort(32);
+
+            // non PCM formats are meant to say how long they are
+            stream.write("fact", 4);
+            stream.writeInt(4);
+            stream.writeInt((int) numFrames);
+
+            stream.write("data", 4);
+            stream.writeInt((int) dataBytes);
+        }
+
+        jassert(stream.getPosition() == headerBytes);
+
+        if (dataBytes > 0)
+        {
+            stream.setPosition(headerBytes + dataBytes - 1);
+            stream.writeByte(0);
+        }
+
+        stream.flush();
+
+        if (stream.getStatus().failed())
+        {
+            errorMessage = "can't write " + file.getFullPathName() + ": " + stream.getStatus().getErrorMessage();
+            return {};
+        }
+    }
+
+    std::unique_ptr<MappedAudioFile> result(new MappedAudioFile());
+    result->mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readWrite);
+
+    if (result->mapping->getData() == nullptr)
+    {
+        errorMessage = "can't map " + file.getFullPathName();
+        return {};
+    }
+
+    result->isWritable = true;
+    result->sampleData = static_cast<juce::uint8*>(result->mapping->getData()) + headerBytes;
+    result->sampleDataBytes = (size_t) dataBytes;
+    result->sampleRate = sampleRate;
+    result->numChannels = numChannels;
+    result->lengthInFrames = numFrames;
+    result->format = SampleFormat::float32;
+    result->isBigEndian = juce::ByteOrder::isBigEndian();
+    result->bytesPerSample = (int) sizeof(float);
+    result->bytesPerFrame = numChannels * (int) sizeof(float);
+
+    return result;
+}
+
+// =============================================================================
+float* MappedAudioFile::getMonoSamples() const
+{
+    if (isWritable && numChannels == 1 && format == SampleFormat::float32
+         && isBigEndian == juce::ByteOrder::isBigEndian())
+        return reinterpret_cast<float*>(sampleData);
+
+    return nullptr;
+}
+
+void MappedAudioFile::readChannel(const int channel, const juce::int64 startFrame, const int numToRead,
+                                    float* destination) const noexcept
+{
+    auto numAvailable = (int) juce::jlimit((juce::int64) 0, (juce::int64) numToRead, lengthInFrames - startFrame);
+    std::fill(destination + numAvailable, destination + numToRead, 0.f);
+
+    if (numAvailable == 0)
+        return;
+
+    auto* source = sampleData + startFrame * bytesPerFrame + channel * bytesPerSample;
+
+    if (format == SampleFormat::int24)
+    {
+        ShitKernels::getKernels().int24ToFloat(source, bytesPerFrame, destination, numAvailable, isBigEndian);
+    }
+    else if (isBigEndian != juce::ByteOrder::isBigEndian())
+    {
+        for (int i = 0; i < numAvailable; ++i)
+        {
+            auto bits = juce::ByteOrder::swap(*reinterpret_cast<const juce::uint32*>(source + i * bytesPerFrame));
+            std::memcpy(destination + i, &bits, sizeof(float));
+        }
+    }
+    else if (numChannels == 1)
+    {
+        std::memcpy(destination, source, (size_t) numAvailable * sizeof(float));
+    }
+    else
+    {
+        for (int i = 0; i < numAvailable; ++i)
+            std::memcpy(destination + i, source + i * bytesPerFrame, sizeof(float));
+    }
+}
+
+void MappedAudioFile::writeChannel(const int channel, const juce::int64 startFrame, const int numToWrite,
+                                    const float* source) noexcept
+{
+    jassert(isWritable && format == SampleFormat::float32);
+    jassert(startFrame + numToWrite <= lengthInFrames);
+
+    // our own files, so native order and aligned
+    auto* destination = reinterpret_cast<float*>(sampleData + startFrame * bytesPerFrame) + channel;
+
+    for (int i = 0; i < numToWrite; ++i)
+        destination[i * numChannels] = source[i];
+}
+
+// =============================================================================
+void MappedAudioFile::adviseSequential() const
+{
+   #if MAPPEDAUDIOFILE_HAS_MADVISE
+    madvise(mapping->getData(), mapping->getSize(), MADV_SEQUENTIAL);
+   #endif
+}
+
+void MappedAudioFile::prefetch(const juce::int64 startFrame, const juce::int64 numToPrefetch) const
+{
+   #if MAPPEDAUDIOFILE_HAS_MADVISE
+    auto* mappingStart = static_cast<juce::uint8*>(mapping->getData());
+    auto mappingEnd = (juce::int64) mapping->getSize();
+
+    auto start = juce::jmin(mappingEnd, (juce::int64) (sampleData - mappingStart) + startFrame * bytesPerFrame);
+    auto end = juce::jmin(mappingEnd, start + numToPrefetch * bytesPerFrame);
+
+    // madvise wants a page aligned start, the mapping itself is one
+    static const auto pageSize = (juce::int64) sysconf(_SC_PAGESIZE);
+    start -= start % pageSize;
+
+    if (end > start)
+        madvise(mappingStart + start, (size_t) (end - start), MADV_WILLNEED);
+   #else
+    juce::ignoreUnused(startFrame, numToPrefetch);
+   #endif
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    MappedAudioFile.h
+    Created: 19 Oct 2026 11:48:05pm
+    Author:  bob
+
+    A WAV or CAF file mapped into memory, for offline renders that read and
+    write sample data where it sits instead of going through AudioBuffers.
+    Reads 32 bit float and packed 24 bit PCM, in either byte order for CAF.
+    Writes 32 bit float.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class MappedAudioFile
+{
+public:
+    // =============================================================================
+    enum class SampleFormat
+    {
+        float32,
+        int24
+    };
+
+    // Null, with errorMessage set, if the file can't be mapped or isn't in a
+    // format this reads
+    static std::unique_ptr<MappedAudioFile> openForReading(const juce::File& file,
+                                                            juce::String& errorMessage);
+
+    // Creates, or replaces, a 32 bit float file of the given size, WAV or
+    // CAF going by the extension, mapped for writing
+    static std::unique_ptr<MappedAudioFile> createForWriting(const juce::File& file,
+                                                                const double sampleRate,
+                                                                const int numChannels,
+                                                                const juce::int64 numFrames,
+                                                                juce::String& errorMessage);
+
+    double getSampleRate() const { return sampleRate; }
+    int getNumChannels() const { return numChannels; }
+    juce::int64 getLengthInFrames() const { return lengthInFrames; }
+
+    // A mono, native float, writable file's samples, for processing in place.
+    // Null for anything else.
+    float* getMonoSamples() const;
+
+    // Frames [startFrame, startFrame + numToRead) of one channel as floats.
+    // Anything past the end reads as silence.
+    void readChannel(const int channel, const juce::int64 startFrame, const int numToRead,
+                        float* destination) const noexcept;
+
+    // Into one channel of a file made by createForWriting()
+    void writeChannel(const int channel, const juce::int64 startFrame, const int numToWrite,
+                        const float* source) noexcept;
+
+    // Readahead hints. The file gets read front to back, and the given frames
+    // are wanted soon. Only does anything where there's madvise().
+    void adviseSequential() const;
+    void prefetch(const juce::int64 startFrame, const juce::int64 numToPrefetch) const;
+
+private:
+    //==============================================================================
+    MappedAudioFile() = default;
+
+    bool parseWav(juce::String& errorMessage);
+    bool parseCaf(juce::String& errorMessage);
+
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    bool isWritable = false;
+
+    juce::uint8* sampleData = nullptr;
+    size_t sampleDataBytes = 0;
+
+    double sampleRate = 0.0;
+    int numChannels = 0;
+    juce::int64 lengthInFrames = 0;
+    SampleFormat format = SampleFormat::float32;
+    bool isBigEndian = false;
+    int bytesPerSample = 4;
+    int bytesPerFrame = 4;
+
+    JUCE_DECLARE_NON_COPYABLE(MappedAudioFile)
+};
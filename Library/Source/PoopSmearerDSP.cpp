@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+    PoopSmearerDSP.cpp
+    Created: 19 Oct 2026 7:30:16pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "PoopSmearerDSP.h"
+#include "MappedAudioFile.h"
+#include "../../Source/ShitClipper.h"
+
+namespace PoopSmearerDSP
+{
+namespace
+{
+    ChainSettings toChainSettings(const Parameters& parameters)
+    {
+        ChainSettings settings;
+
+        settings.isBypassed = parameters.bypass;
+        settings.cabEnabled = parameters.cabinet;
+        // an out of range tier would index past the engine's per tier tables
+        settings.quality = static_cast<QualityTier>(juce::jlimit(0, numQualityTiers - 1, (int) parameters.quality));
+        settings.drive = parameters.drive;
+        settings.tone = parameters.tone;
+        settings.level = parameters.level;
+        settings.numBands = juce::jlimit(1, maxClipBands, parameters.numBands);
+
+        for (int band = 0; band < maxClipBands; ++band)
+            settings.bandTrims[(size_t) band] = parameters.bandTrims[band];
+
+        settings.numStages = juce::jlimit(1, maxStages, parameters.numStages);
+
+        for (int stage = 0; stage < maxStages - 1; ++stage)
+        {
+            auto& stageParameters = parameters.stackedStages[stage];
+            settings.stackedStages[(size_t) stage] = { stageParameters.drive,
+                                                       stageParameters.tone,
+                                                       stageParameters.level };
+        }
+
+        return settings;
+    }
+
+    // =============================================================================
+    // File renders go through in tiles this long, and ask for the input a
+    // readahead window at a time
+    constexpr int renderTileSize = 1024;
+    constexpr juce::int64 readaheadFrames = 1 << 18;
+
+    bool renderMappedFile(const juce::File& inputFile,
+                            const juce::File& outputFile,
+                            const Parameters& parameters,
+                            juce::String& errorMessage)
+    {
+        if (inputFile == outputFile)
+        {
+            errorMessage = "can't render a file over itself";
+            return false;
+        }
+
+        auto input = MappedAudioFile::openForReading(inputFile, errorMessage);
+
+        if (input == nullptr)
+            return false;
+
+        const auto sampleRate = input->getSampleRate();
+        const auto numChannels = input->getNumChannels();
+        const auto numFrames = input->getLengthInFrames();
+
+        auto output = MappedAudioFile::createForWriting(outputFile, sampleRate, numChannels, numFrames, errorMessage);
+
+        if (output == nullptr)
+            return false;
+
+        // One offline engine per channel, so every tile of the input gets
+        // read once while it's still in cache
+        const auto settings = toChainSettings(parameters);
+        std::vector<std::unique_ptr<ShitClipper>> engines;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            engines.push_back(std::make_unique<ShitClipper>());
+            engines.back()->setNonRealtime(true);
+            engines.back()->prepare({ sampleRate, (juce::uint32) renderTileSize, 1 }, sampleRate, settings);
+        }
+
+        // The input is run on past its end by the latency, reading as
+        // silence, and the first latency samples out are dropped, so the
+        // output lines up with it
+        const auto latency = engines.empty() ? (juce::int64) 0 : (juce::int64) engines.front()->getLatencySamples();
+        const auto renderEnd = numFrames + latency;
+
+        // Mono float output gets processed right where it's going
+        auto* outputSamples = output->getMonoSamples();
+        std::vector<float> scratch((size_t) renderTileSize);
+
+        input->adviseSequential();
+        output->adviseSequential();
+
+        juce::int64 prefetchedEnd = 0;
+
+        for (juce::int64 position = 0; position < renderEnd;)
+        {
+            if (position >= prefetchedEnd - readaheadFrames / 2)
+            {
+                input->prefetch(prefetchedEnd, readaheadFrames);
+                prefetchedEnd += readaheadFrames;
+            }
+
+            // tiles stop at the end of the latency so the rest start in the output
+            const auto tileEnd = position < latency ? latency : renderEnd;
+            const auto numToProcess = (int) juce::jmin((juce::int64) renderTileSize, tileEnd - position);
+            const auto outputFrame = position - latency;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto isInPlace = outputSamples != nullptr && outputFrame >= 0;
+                auto* samples = isInPlace ? outputSamples + outputFrame : scratch.data();
+
+                input->readChannel(channel, position, numToProcess, samples);
+
+                float* channels[] = { samples };
+                juce::AudioBuffer<float> buffer(channels, 1, numToProcess);
+                engines[(size_t) channel]->process(buffer, sampleRate, settings);
+
+                if (!isInPlace && outputFrame >= 0)
+                    output->writeChannel(channel, outputFrame, numToProcess, samples);
+            }
+
+            position += numToProcess;
+        }
+
+        return true;
+    }
+}
+
+// =============================================================================
+struct Engine::Impl
+{
+    ShitClipper shitClipper;
+    double sampleRate = 48000.0;
+};
+
+Engine::Engine() : impl(std::make_unique<Impl>())
+{}
+
+Engine::~Engine() = default;
+
+Engine::Engine(Engine&&) noexcept = default;
+Engine& Engine::operator=(Engine&&) noexcept = default;
+
+// =============================================================================
+void Engine::prepare(const Config& config, const Parameters& parameters)
+{
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = (juce::uint32) config.maximumBlockSize;
+    spec.numChannels = 1;
+    spec.sampleRate = config.sampleRate;
+
+    impl->sampleRate = config.sampleRate;
+    impl->shitClipper.setNonRealtime(config.offline);
+    impl->shitClipper.setAdaptiveQuality(config.adaptiveQuality);
+    impl->shitClipper.prepare(spec, config.sampleRate, toChainSettings(parameters));
+}
+
+void Engine::process(float* samples, int numSamples, const Parameters& parameters)
+{
+    // wraps the caller's memory, no copy
+    float* channels[] = { samples };
+    juce::AudioBuffer<float> buffer(channels, 1, numSamples);
+
+    impl->shitClipper.process(buffer, impl->sampleRate, toChainSettings(parameters));
+}
+
+// =============================================================================
+bool Engine::loadCabinetImpulseResponse(const char* filePath)
+{
+    juce::File irFile(juce::String::fromUTF8(filePath));
+
+    if (!irFile.existsAsFile())
+        return false;
+
+    impl->shitClipper.loadCabinetImpulseResponse(irFile);
+    return true;
+}
+
+void Engine::loadCabinetImpulseResponse(const void* fileData, std::size_t fileDataSize)
+{
+    impl->shitClipper.loadCabinetImpulseResponse(fileData, fileDataSize);
+}
+
+int Engine::getLatencySamples() const
+{
+    return impl->shitClipper.getLatencySamples();
+}
+
+double Engine::getTailLengthSeconds() const
+{
+    return impl->shitClipper.getTailLengthSeconds();
+}
+
+// =============================================================================
+bool renderFile(const char* inputPath,
+                const char* outputPath,
+                const Parameters& parameters,
+                std::string* errorMessage)
+{
+    juce::String error;
+
+    auto rendered = renderMappedFile(juce::File(juce::String::fromUTF8(inputPath)),
+                                        juce::File(juce::String::fromUTF8(outputPath)),
+                                        parameters,
+                                        error);
+
+    if (!rendered && errorMessage != nullptr)
+        *errorMessage = error.toStdString();
+
+    return rendered;
+}
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    PoopSmearerDSP.h
+    Created: 19 Oct 2026 7:30:16pm
+    Author:  bob
+
+    Plain C++ front end to the PoopSmearer engine, for linking the DSP into
+    render workers without the plugin, GUI or audio device code. Nothing in
+    here needs JUCE headers. For C callers see PoopSmearerDSP_C.h.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace PoopSmearerDSP
+{
+    enum class Quality
+    {
+        eco,
+        normal,
+        high
+    };
+
+    // Knobs of one stacked stage
+    struct StageParameters
+    {
+        float drive = 5.f;              // 0 - 10
+        float tone = 5.f;               // 0 - 10
+        float level = 5.f;              // 0 - 10
+    };
+
+    // Same ranges as the plugin's parameters
+    struct Parameters
+    {
+        bool bypass = false;
+        bool cabinet = false;           // only once an IR is loaded
+        Quality quality = Quality::normal;
+        float drive = 5.f;              // 0 - 10
+        float tone = 5.f;               // 0 - 10
+        float level = 5.f;              // 0 - 10
+
+        // Multiband clip, 1 - 4 bands. Each band's drive is offset by its
+        // trim, -12 - 12 dB.
+        int numBands = 1;
+        float bandTrims[4] = {};
+
+        // 1 - 3 pedal stages in series. drive, tone and level are the first
+        // stage's, stackedStages the ones after it.
+        int numStages = 1;
+        StageParameters stackedStages[2];
+    };
+
+    struct Config
+    {
+        double sampleRate = 48000.0;
+        int maximumBlockSize = 512;
+
+        // Offline renders always run at the highest quality and get the full
+        // engine from prepare() on. Real-time use builds it in the background.
+        bool offline = true;
+
+        // Drop quality tiers when processing gets close to the block deadline.
+        // Only has an effect when not offline.
+        bool adaptiveQuality = false;
+    };
+
+    // One mono pedal. Not thread safe - use one per stream.
+    class Engine
+    {
+    public:
+        Engine();
+        ~Engine();
+
+        Engine(Engine&&) noexcept;
+        Engine& operator=(Engine&&) noexcept;
+
+        void prepare(const Config& config, const Parameters& parameters);
+
+        // Process numSamples in place. Parameter changes are picked up every
+        // 64 samples.
+        void process(float* samples, int numSamples, const Parameters& parameters);
+
+        // Cabinet IRs load in the background, with a crossfade once ready.
+        // Returns false if the file doesn't exist.
+        bool loadCabinetImpulseResponse(const char* filePath);
+        void loadCabinetImpulseResponse(const void* fileData, std::size_t fileDataSize);
+
+        int getLatencySamples() const;
+        double getTailLengthSeconds() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+    };
+
+    // Renders a whole WAV or CAF file offline into a 32 bit float one of the
+    // same rate, channel count and length, the engine's latency taken out.
+    // Both files are memory mapped. The input can be 32 bit float or 24 bit
+    // PCM, the output is a CAF if its name ends in .caf and a WAV otherwise.
+    // No cabinet, there's no IR to load. On failure returns false and fills
+    // in errorMessage if there is one.
+    bool renderFile(const char* inputPath,
+                    const char* outputPath,
+                    const Parameters& parameters,
+                    std::string* errorMessage = nullptr);
+}
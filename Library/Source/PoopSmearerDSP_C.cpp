@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    PoopSmearerDSP_C.cpp
+    Created: 19 Oct 2026 7:30:16pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "PoopSmearerDSP_C.h"
+#include "PoopSmearerDSP.h"
+
+#include <algorithm>
+
+// The C handle is the C++ engine
+struct PoopSmearerEngine
+{
+    PoopSmearerDSP::Engine engine;
+};
+
+namespace
+{
+    PoopSmearerDSP::Parameters toParameters(const PoopSmearerParameters* parameters)
+    {
+        PoopSmearerDSP::Parameters result;
+
+        if (parameters != nullptr)
+        {
+            result.bypass = parameters->bypass != 0;
+            result.cabinet = parameters->cabinet != 0;
+            result.quality = static_cast<PoopSmearerDSP::Quality>(std::clamp(parameters->quality,
+                                                                              (int) POOPSMEARER_QUALITY_ECO,
+                                                                              (int) POOPSMEARER_QUALITY_HIGH));
+            result.drive = parameters->drive;
+            result.tone = parameters->tone;
+            result.level = parameters->level;
+            result.numBands = parameters->numBands;
+
+            for (int band = 0; band < 4; ++band)
+                result.bandTrims[band] = parameters->bandTrims[band];
+
+            result.numStages = parameters->numStages;
+
+            for (int stage = 0; stage < 2; ++stage)
+            {
+                result.stackedStages[stage].drive = parameters->stackedStages[stage].drive;
+                result.stackedStages[stage].tone = parameters->stackedStages[stage].tone;
+                result.stackedStages[stage].level = parameters->stackedStages[stage].level;
+            }
+        }
+
+        return result;
+    }
+}
+
+// =============================================================================
+void poopsmearer_default_parameters(PoopSmearerParameters* parameters)
+{
+    PoopSmearerDSP::Parameters defaults;
+
+    parameters->bypass = defaults.bypass ? 1 : 0;
+    parameters->cabinet = defaults.cabinet ? 1 : 0;
+    parameters->quality = static_cast<int>(defaults.quality);
+    parameters->drive = defaults.drive;
+    parameters->tone = defaults.tone;
+    parameters->level = defaults.level;
+    parameters->numBands = defaults.numBands;
+
+    for (int band = 0; band < 4; ++band)
+        parameters->bandTrims[band] = defaults.bandTrims[band];
+
+    parameters->numStages = defaults.numStages;
+
+    for (int stage = 0; stage < 2; ++stage)
+    {
+        parameters->stackedStages[stage].drive = defaults.stackedStages[stage].drive;
+        parameters->stackedStages[stage].tone = defaults.stackedStages[stage].tone;
+        parameters->stackedStages[stage].level = defaults.stackedStages[stage].level;
+    }
+}
+
+void poopsmearer_default_config(PoopSmearerConfig* config)
+{
+    PoopSmearerDSP::Config defaults;
+
+    config->sampleRate = defaults.sampleRate;
+    config->maximumBlockSize = defaults.maximumBlockSize;
+    config->offline = defaults.offline ? 1 : 0;
+    config->adaptiveQuality = defaults.adaptiveQuality ? 1 : 0;
+}
+
+// =============================================================================
+// Nothing may throw across the C boundary, so everything that gets into the
+// engine catches whatever comes out of it (std::bad_alloc from the JUCE
+// containers, std::system_error from the table builder's threads...) and
+// turns it into the error return. Filling in defaults and destroying can't
+// throw.
+PoopSmearerEngine* poopsmearer_create(void)
+{
+    try
+    {
+        return new PoopSmearerEngine();
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void poopsmearer_destroy(PoopSmearerEngine* engine)
+{
+    delete engine;
+}
+
+int poopsmearer_prepare(PoopSmearerEngine* engine,
+                        const PoopSmearerConfig* config,
+                        const PoopSmearerParameters* parameters)
+{
+    try
+    {
+        PoopSmearerDSP::Config cppConfig;
+
+        if (config != nullptr)
+        {
+            cppConfig.sampleRate = config->sampleRate;
+            cppConfig.maximumBlockSize = config->maximumBlockSize;
+            cppConfig.offline = config->offline != 0;
+            cppConfig.adaptiveQuality = config->adaptiveQuality != 0;
+        }
+
+        engine->engine.prepare(cppConfig, toParameters(parameters));
+        return 1;
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+int poopsmearer_process(PoopSmearerEngine* engine,
+                        float* samples,
+                        int numSamples,
+                        const PoopSmearerParameters* parameters)
+{
+    try
+    {
+        engine->engine.process(samples, numSamples, toParameters(parameters));
+        return 1;
+    }
+    catch (...)
+    {
+        // whatever got half processed is no use to anyone
+        std::fill(samples, samples + numSamples, 0.f);
+        return 0;
+    }
+}
+
+// =============================================================================
+int poopsmearer_load_cabinet_ir_file(PoopSmearerEngine* engine, const char* filePath)
+{
+    try
+    {
+        return engine->engine.loadCabinetImpulseResponse(filePath) ? 1 : 0;
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+int poopsmearer_load_cabinet_ir_data(PoopSmearerEngine* engine, const void* fileData, size_t fileDataSize)
+{
+    try
+    {
+        engine->engine.loadCabinetImpulseResponse(fileData, fileDataSize);
+        return 1;
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+int poopsmearer_get_latency_samples(const PoopSmearerEngine* engine)
+{
+    try
+    {
+        return engine->engine.getLatencySamples();
+    }
+    catch (...)
+    {
+        return -1;
+    }
+}
+
+double poopsmearer_get_tail_length_seconds(const PoopSmearerEngine* engine)
+{
+    try
+    {
+        return engine->engine.getTailLengthSeconds();
+    }
+    catch (...)
+    {
+        return -1.0;
+    }
+}
+
+// =============================================================================
+int poopsmearer_render_file(const char* inputPath,
+                            const char* outputPath,
+                            const PoopSmearerParameters* parameters)
+{
+    try
+    {
+        return PoopSmearerDSP::renderFile(inputPath, outputPath, toParameters(parameters)) ? 1 : 0;
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    PoopSmearerDSP_C.h
+    Created: 19 Oct 2026 7:30:16pm
+    Author:  bob
+
+    C interface to PoopSmearerDSP::Engine, for callers that can't link C++.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PoopSmearerEngine PoopSmearerEngine;
+
+enum
+{
+    POOPSMEARER_QUALITY_ECO = 0,
+    POOPSMEARER_QUALITY_NORMAL = 1,
+    POOPSMEARER_QUALITY_HIGH = 2
+};
+
+typedef struct PoopSmearerStageParameters
+{
+    float drive;            /* 0 - 10 */
+    float tone;             /* 0 - 10 */
+    float level;            /* 0 - 10 */
+} PoopSmearerStageParameters;
+
+typedef struct PoopSmearerParameters
+{
+    int bypass;
+    int cabinet;
+    int quality;            /* POOPSMEARER_QUALITY_* */
+    float drive;            /* 0 - 10 */
+    float tone;             /* 0 - 10 */
+    float level;            /* 0 - 10 */
+    int numBands;           /* 1 - 4 */
+    float bandTrims[4];     /* dB, -12 - 12 */
+    int numStages;          /* 1 - 3, drive/tone/level are the first stage's */
+    PoopSmearerStageParameters stackedStages[2];
+} PoopSmearerParameters;
+
+typedef struct PoopSmearerConfig
+{
+    double sampleRate;
+    int maximumBlockSize;
+    int offline;
+    int adaptiveQuality;
+} PoopSmearerConfig;
+
+/* Fill in the same defaults as the C++ API */
+void poopsmearer_default_parameters(PoopSmearerParameters* parameters);
+void poopsmearer_default_config(PoopSmearerConfig* config);
+
+/* Returns NULL if the engine couldn't be created */
+PoopSmearerEngine* poopsmearer_create(void);
+void poopsmearer_destroy(PoopSmearerEngine* engine);
+
+/* Returns 0 on failure, e.g. out of memory */
+int poopsmearer_prepare(PoopSmearerEngine* engine,
+                        const PoopSmearerConfig* config,
+                        const PoopSmearerParameters* parameters);
+
+/* Mono, in place. Returns 0 on failure, with the block silenced. */
+int poopsmearer_process(PoopSmearerEngine* engine,
+                        float* samples,
+                        int numSamples,
+                        const PoopSmearerParameters* parameters);
+
+/* Returns 0 if the file doesn't exist, or on failure */
+int poopsmearer_load_cabinet_ir_file(PoopSmearerEngine* engine, const char* filePath);
+
+/* Returns 0 on failure */
+int poopsmearer_load_cabinet_ir_data(PoopSmearerEngine* engine, const void* fileData, size_t fileDataSize);
+
+/* Both return -1 on failure */
+int poopsmearer_get_latency_samples(const PoopSmearerEngine* engine);
+double poopsmearer_get_tail_length_seconds(const PoopSmearerEngine* engine);
+
+/* Renders a WAV or CAF file offline into a 32 bit float WAV, or a CAF if
+   outputPath ends in .caf. Returns 0 on failure. */
+int poopsmearer_render_file(const char* inputPath,
+                            const char* outputPath,
+                            const PoopSmearerParameters* parameters);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+    PoopSmearerRenderService.cpp
+    Created: 20 Oct 2026 12:31:47am
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "PoopSmearerRenderService.h"
+
+#include <JuceHeader.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace PoopSmearerDSP
+{
+// =============================================================================
+struct RenderService::Stream::State
+{
+    explicit State(RenderService::Impl& owner) : service(owner) {}
+
+    struct Job
+    {
+        Block samples;
+        Parameters parameters;
+        Completion onProcessed;
+    };
+
+    RenderService::Impl& service;
+    Engine engine;
+    int latencySamples = 0;
+
+    std::mutex lock;
+    std::condition_variable spaceAvailable;
+    std::deque<Job> jobs;
+
+    // On the ready queue or being processed. Only one render thread has the
+    // stream at a time, and it's the only one that touches jobs.front().
+    bool isScheduled = false;
+};
+
+// =============================================================================
+struct RenderService::Impl
+{
+    class RenderThread : public juce::Thread
+    {
+    public:
+        explicit RenderThread(Impl& ownerService)
+            : juce::Thread("PoopSmearer render"),
+              service(ownerService)
+        {}
+
+        void run() override
+        {
+            while (auto stream = service.waitForStream())
+                service.renderNextBlock(stream);
+        }
+
+    private:
+        Impl& service;
+    };
+
+    explicit Impl(const Options& options)
+        : maxQueuedBlocks(juce::jmax(1, options.maxQueuedBlocksPerStream))
+    {
+        auto numThreads = options.numThreads > 0 ? options.numThreads : juce::SystemStats::getNumCpus();
+
+        for (int i = 0; i < numThreads; ++i)
+            threads.add(new RenderThread(*this))->startThread();
+    }
+
+    ~Impl()
+    {
+        // every stream should be closed by now
+        jassert(numOpenStreams.load() == 0);
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            shouldStop = true;
+        }
+
+        workAvailable.notify_all();
+
+        for (auto* thread : threads)
+            thread->stopThread(-1);
+
+        // Streams still on the ready queue drop their jobs here, breaking
+        // any futures that were waiting on them
+        readyStreams.clear();
+    }
+
+    void schedule(std::shared_ptr<Stream::State> stream)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            readyStreams.push_back(std::move(stream));
+        }
+
+        workAvailable.notify_one();
+    }
+
+    // Null once the service is stopping
+    std::shared_ptr<Stream::State> waitForStream()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        workAvailable.wait(guard, [this] { return shouldStop || !readyStreams.empty(); });
+
+        if (shouldStop)
+            return {};
+
+        auto stream = std::move(readyStreams.front());
+        readyStreams.pop_front();
+
+        return stream;
+    }
+
+    // One block, then the stream goes to the back of the queue if it has
+    // more, so a long upload can't hold a thread while others wait
+    void renderNextBlock(const std::shared_ptr<Stream::State>& stream)
+    {
+        Stream::State::Job* job;
+
+        {
+            std::lock_guard<std::mutex> guard(stream->lock);
+            job = &stream->jobs.front();
+        }
+
+        stream->engine.process(job->samples.data(), (int) job->samples.size(), job->parameters);
+
+        // before the stream can be picked up again, so completions come in order
+        job->onProcessed(std::move(job->samples));
+
+        bool hasMore;
+
+        {
+            std::lock_guard<std::mutex> guard(stream->lock);
+            stream->jobs.pop_front();
+            hasMore = !stream->jobs.empty();
+            stream->isScheduled = hasMore;
+        }
+
+        stream->spaceAvailable.notify_all();
+
+        if (hasMore)
+            schedule(stream);
+    }
+
+    const int maxQueuedBlocks;
+    std::atomic<int> numOpenStreams { 0 };
+
+    std::mutex lock;
+    std::condition_variable workAvailable;
+    std::deque<std::shared_ptr<Stream::State>> readyStreams;
+    bool shouldStop = false;
+
+    juce::OwnedArray<RenderThread> threads;
+};
+
+// =============================================================================
+RenderService::RenderService(const Options& options) : impl(std::make_unique<Impl>(options))
+{}
+
+RenderService::~RenderService() = default;
+
+std::unique_ptr<RenderService::Stream> RenderService::openStream(const Config& config, const Parameters& parameters)
+{
+    auto state = std::make_shared<Stream::State>(*impl);
+    state->engine.prepare(config, parameters);
+    state->latencySamples = state->engine.getLatencySamples();
+
+    ++impl->numOpenStreams;
+
+    return std::unique_ptr<Stream>(new Stream(std::move(state)));
+}
+
+int RenderService::getNumThreads() const
+{
+    return impl->threads.size();
+}
+
+// =============================================================================
+RenderService::Stream::Stream(std::shared_ptr<State> streamState) : state(std::move(streamState))
+{}
+
+RenderService::Stream::~Stream()
+{
+    // the ready queue keeps the state alive until its jobs are done
+    --state->service.numOpenStreams;
+}
+
+std::future<RenderService::Block> RenderService::Stream::submit(Block samples, const Parameters& parameters)
+{
+    // Completion has to be copyable, so the promise gets shared
+    auto promise = std::make_shared<std::promise<Block>>();
+    auto result = promise->get_future();
+
+    enqueue(samples, parameters, [promise] (Block processed) { promise->set_value(std::move(processed)); }, true);
+
+    return result;
+}
+
+bool RenderService::Stream::trySubmit(Block& samples, const Parameters& parameters, Completion onProcessed)
+{
+    return enqueue(samples, parameters, std::move(onProcessed), false);
+}
+
+bool RenderService::Stream::enqueue(Block& samples,
+                                    const Parameters& parameters,
+                                    Completion&& onProcessed,
+                                    bool shouldWait)
+{
+    auto& service = state->service;
+    std::unique_lock<std::mutex> guard(state->lock);
+
+    auto hasSpace = [this, &service] { return (int) state->jobs.size() < service.maxQueuedBlocks; };
+
+    if (shouldWait)
+        state->spaceAvailable.wait(guard, hasSpace);
+    else if (!hasSpace())
+        return false;
+
+    state->jobs.push_back({ std::move(samples), parameters, std::move(onProcessed) });
+
+    if (state->isScheduled)
+        return true;
+
+    state->isScheduled = true;
+    guard.unlock();
+
+    service.schedule(state);
+    return true;
+}
+
+int RenderService::Stream::getNumQueuedBlocks() const
+{
+    std::lock_guard<std::mutex> guard(state->lock);
+    return (int) state->jobs.size();
+}
+
+int RenderService::Stream::getLatencySamples() const
+{
+    return state->latencySamples;
+}
+}
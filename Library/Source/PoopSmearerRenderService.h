@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    PoopSmearerRenderService.h
+    Created: 20 Oct 2026 12:31:47am
+    Author:  bob
+
+    Lots of render streams sharing a fixed set of threads, for services that
+    take many uploads at once. Every stream is its own Engine. Its blocks are
+    processed in the order they were submitted, one at a time, by whichever
+    render thread gets to it first, and each stream can only have so many
+    blocks waiting before submitting blocks the caller. Nothing in here needs
+    JUCE headers.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PoopSmearerDSP.h"
+
+#include <functional>
+#include <future>
+#include <vector>
+
+namespace PoopSmearerDSP
+{
+    class RenderService
+    {
+    public:
+        struct Options
+        {
+            int numThreads = 0;                 // 0 for one per CPU core
+            int maxQueuedBlocksPerStream = 8;
+        };
+
+        // Mono samples, any length
+        using Block = std::vector<float>;
+
+        // Called on a render thread with the processed block. Mustn't throw
+        // or submit to its own stream.
+        using Completion = std::function<void(Block processed)>;
+
+        // One upload's engine and queue. Close it before the service by
+        // destroying it - blocks already submitted still get processed.
+        class Stream
+        {
+        public:
+            ~Stream();
+
+            // Queues a block, processed with these parameters, and waits
+            // while the stream already has its maximum queued
+            std::future<Block> submit(Block samples, const Parameters& parameters);
+
+            // Never waits. If the stream's queue is full, returns false and
+            // leaves samples alone, otherwise takes them.
+            bool trySubmit(Block& samples, const Parameters& parameters, Completion onProcessed);
+
+            int getNumQueuedBlocks() const;
+            int getLatencySamples() const;
+
+        private:
+            friend class RenderService;
+            struct State;
+
+            explicit Stream(std::shared_ptr<State> streamState);
+            bool enqueue(Block& samples, const Parameters& parameters, Completion&& onProcessed, bool shouldWait);
+
+            std::shared_ptr<State> state;
+        };
+
+        explicit RenderService(const Options& options);
+        ~RenderService();
+
+        // Prepares the stream's engine on the calling thread
+        std::unique_ptr<Stream> openStream(const Config& config, const Parameters& parameters);
+
+        int getNumThreads() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+    };
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    ChainSettings.h
+    Created: 19 Oct 2026 2:18:40pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+
+// Quality tiers - each one is a fixed set of trade-offs:
+//   eco     fast tanh approximation, no oversampling
+//   normal  exact tanh, 2x oversampling
+//   high    antiderivative anti-aliased tanh, 4x oversampling
+enum class QualityTier
+{
+    eco,
+    normal,
+    high
+};
+
+static constexpr int numQualityTiers = 3;
+
+// Clip stage oversampling factor for a tier, 1x / 2x / 4x
+constexpr int getOversamplingFactor(QualityTier tier)
+{
+    return 1 << (int) tier;
+}
+
+// Most bands the multiband clip stage can split into
+static constexpr int maxClipBands = 4;
+
+// Most pedal stages that can be stacked in series
+static constexpr int maxStages = 3;
+
+// Knobs of one stacked stage, same ranges as the main ones
+struct StageSettings
+{
+    float drive { 0 }, tone { 0 }, level { 0 };
+};
+
+inline bool operator==(const StageSettings& a, const StageSettings& b)
+{
+    return a.drive == b.drive
+        && a.tone == b.tone
+        && a.level == b.level;
+}
+
+inline bool operator!=(const StageSettings& a, const StageSettings& b)
+{
+    return !(a == b);
+}
+
+struct ChainSettings
+{
+    bool isBypassed = false;
+    bool cabEnabled = false;
+    QualityTier quality = QualityTier::normal;
+    float drive { 0 }, tone { 0 }, level { 0 };
+
+    // Multiband clip: 1 is the plain single band clipper. Each band's drive
+    // is Drive plus its trim in dB.
+    int numBands = 1;
+    std::array<float, maxClipBands> bandTrims {};
+
+    // Stacked stages: the pedal run this many times in series, as if chained
+    // instances. Drive, Tone and Level above are the first stage's, the
+    // others have their own.
+    int numStages = 1;
+    std::array<StageSettings, maxStages - 1> stackedStages {};
+};
+
+inline bool operator==(const ChainSettings& a, const ChainSettings& b)
+{
+    return a.isBypassed == b.isBypassed
+        && a.cabEnabled == b.cabEnabled
+        && a.quality == b.quality
+        && a.drive == b.drive
+        && a.tone == b.tone
+        && a.level == b.level
+        && a.numBands == b.numBands
+        && a.bandTrims == b.bandTrims
+        && a.numStages == b.numStages
+        && a.stackedStages == b.stackedStages;
+}
+
+inline bool operator!=(const ChainSettings& a, const ChainSettings& b)
+{
+    return !(a == b);
+}
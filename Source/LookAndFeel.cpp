@@ -1,60 +1,78 @@
-/*
-  ==============================================================================
-
-    LookAndFeel.cpp
-    Created: 24 Feb 2022 2:24:01pm
-    Author:  bob
-
-  ==============================================================================
-*/
-
-#include "LookAndFeel.h"
-
-void LookAndFeel::drawRotarySlider(juce::Graphics& g,
-                                    int x, int y, int width, int height,
-                                    float sliderPosProportional,
-                                    float rotaryStartAngle,
-                                    float rotaryEndAngle,
-                                    juce::Slider&)
-{
-    using namespace juce;
-
-    auto bounds = Rectangle<float>(x, y, width, height);
-
-    g.setColour(Colours::silver);
-    g.fillEllipse(bounds);
-
-    g.setColour(Colours::black);
-    g.drawEllipse(bounds, 4.f);
-
-    auto center = bounds.getCentre();
-
-    Path p;
-
-    Rectangle<float> r;
-
-    r.setLeft(center.getX() - 2);
-    r.setRight(center.getX() + 2);
-    r.setTop(bounds.getY());
-    r.setBottom(center.getY());
-
-    p.addRectangle(r);
-
-    jassert(rotaryStartAngle < rotaryEndAngle);
-
-    auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
-
-    p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
-
-    g.fillPath(p);
-}
-
-void LookAndFeel::drawButtonBackground(juce::Graphics& g,
-                            juce::Button& button,
-                            const juce::Colour& backgroundColour,
-                            bool shouldDrawButtonAsHighlighted,
-                            bool shouldDrawButtonAsDown)
-{
-    g.setColour(backgroundColour);
-    g.fillRoundedRectangle(button.getLocalBounds().toFloat(), 8.f);
+/*
+  ==============================================================================
+
+    LookAndFeel.cpp
+    Created: 24 Feb 2022 2:24:01pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "LookAndFeel.h"
+
+void LookAndFeel::drawRotarySlider(juce::Graphics& g,
+                                    int x, int y, int width, int height,
+                                    float sliderPosProportional,
+                                    float rotaryStartAngle,
+                                    float rotaryEndAngle,
+                                    juce::Slider&)
+{
+    using namespace juce;
+
+    auto bounds = Rectangle<float>(x, y, width, height);
+
+    g.setColour(Colours::silver);
+    g.fillEllipse(bounds);
+
+    g.setColour(Colours::black);
+    g.drawEllipse(bounds, 4.f);
+
+    auto center = bounds.getCentre();
+
+    Path p;
+
+    Rectangle<float> r;
+
+    r.setLeft(center.getX() - 2);
+    r.setRight(center.getX() + 2);
+    r.setTop(bounds.getY());
+    r.setBottom(center.getY());
+
+    p.addRectangle(r);
+
+    jassert(rotaryStartAngle < rotaryEndAngle);
+
+    auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
+
+    p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
+
+    g.fillPath(p);
+}
+
+void LookAndFeel::drawButtonBackground(juce::Graphics& g,
+                            juce::Button& button,
+                            const juce::Colour& backgroundColour,
+                            bool shouldDrawButtonAsHighlighted,
+                            bool shouldDrawButtonAsDown)
+{
+    g.setColour(backgroundColour);
+    g.fillRoundedRectangle(button.getLocalBounds().toFloat(), 8.f);
+}
+
+// =============================================================================
+LookAndFeel& SharedEditorResources::getLookAndFeel()
+{
+    if (lookAndFeel == nullptr)
+        lookAndFeel = std::make_unique<LookAndFeel>();
+
+    return *lookAndFeel;
+}
+
+const juce::Image& SharedEditorResources::getPedalImage()
+{
+    if (pedalImage.isNull())
+        pedalImage = juce::ImageCache::getFromMemory(BinaryData::PoopSmearerPedal_png,
+                                                        BinaryData::PoopSmearerPedal_pngSize);
+
+    return pedalImage;
 }
\ No newline at end of file
@@ -1,29 +1,43 @@
-/*
-  ==============================================================================
-
-    LookAndFeel.h
-    Created: 24 Feb 2022 2:24:01pm
-    Author:  bob
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-class LookAndFeel : public juce::LookAndFeel_V4
-{
-    virtual void drawRotarySlider(juce::Graphics& g,
-                                    int x, int y, int width, int height,
-                                    float sliderPosProportional,
-                                    float rotaryStartAngle,
-                                    float rotaryEndAngle,
-                                    juce::Slider&) override;
-
-    virtual void drawButtonBackground(juce::Graphics& g,
-                                        juce::Button& button,
-                                        const juce::Colour& backgroundColour,
-                                        bool shouldDrawButtonAsHighlighted,
-                                        bool shouldDrawButtonAsDown) override;
+/*
+  ==============================================================================
+
+    LookAndFeel.h
+    Created: 24 Feb 2022 2:24:01pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class LookAndFeel : public juce::LookAndFeel_V4
+{
+    virtual void drawRotarySlider(juce::Graphics& g,
+                                    int x, int y, int width, int height,
+                                    float sliderPosProportional,
+                                    float rotaryStartAngle,
+                                    float rotaryEndAngle,
+                                    juce::Slider&) override;
+
+    virtual void drawButtonBackground(juce::Graphics& g,
+                                        juce::Button& button,
+                                        const juce::Colour& backgroundColour,
+                                        bool shouldDrawButtonAsHighlighted,
+                                        bool shouldDrawButtonAsDown) override;
+};
+
+// Editor resources shared by every plugin instance in the process. Held by
+// each processor so they outlive editors being closed and reopened, but
+// nothing gets built or decoded until the first editor asks for it.
+// Message thread only.
+struct SharedEditorResources
+{
+    LookAndFeel& getLookAndFeel();
+    const juce::Image& getPedalImage();
+
+private:
+    std::unique_ptr<LookAndFeel> lookAndFeel;
+    juce::Image pedalImage;
 };
\ No newline at end of file
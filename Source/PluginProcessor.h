@@ -1,78 +1,101 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "ShitClipper.h"
-
-//==============================================================================
-/**
-*/
-
-class PoopSmearerAudioProcessor  : public juce::AudioProcessor
-{
-public:
-    //==============================================================================
-    PoopSmearerAudioProcessor();
-    ~PoopSmearerAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-
-    // =============================================================================
-    bool isBypassed();
-
-    //==============================================================================
-    // Parameter setup
-
-    juce::AudioProcessorValueTreeState apvts {
-        *this,
-        nullptr,
-        "Parameters",
-        shitClipper.createParameterLayout()
-    };
-
-private:
-    //==============================================================================
-    // Shit Clipper Overdrive
-    ShitClipper shitClipper;
-
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PoopSmearerAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ShitChannelBank.h"
+#include "ShitParameters.h"
+#include "LookAndFeel.h"
+
+//==============================================================================
+/**
+*/
+
+class PoopSmearerAudioProcessor  : public juce::AudioProcessor
+{
+public:
+    //==============================================================================
+    PoopSmearerAudioProcessor();
+    ~PoopSmearerAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+    // =============================================================================
+    bool isBypassed();
+
+    // Load a cabinet IR and remember where it came from with the plugin state
+    void loadCabinetImpulseResponse(const juce::File& irFile);
+
+    // False until the engine's background prepare has landed
+    bool isEngineFullyPrepared() const { return channelBank.isFullyPrepared(); }
+
+    // Memory held by the DSP engines, all channels
+    ShitClipper::MemoryFootprint getEngineMemoryFootprint() const
+    {
+        return channelBank.getMemoryFootprint();
+    }
+
+    //==============================================================================
+    // Parameter setup
+
+    juce::AudioProcessorValueTreeState apvts {
+        *this,
+        nullptr,
+        "Parameters",
+        ShitParameters::createParameterLayout()
+    };
+
+private:
+    // State property holding the path of the loaded cabinet IR
+    static constexpr const char* cabIRProperty = "CabIR";
+
+    // Looked up once here, so processBlock never searches by parameter ID
+    ShitParameters::ParameterValues parameterValues { apvts };
+
+    //==============================================================================
+    // Shit Clipper Overdrive, one per channel
+    ShitChannelBank channelBank;
+
+    // Keeps the process-wide editor resources alive between editor openings
+    juce::SharedResourcePointer<SharedEditorResources> editorResources;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PoopSmearerAudioProcessor)
+};
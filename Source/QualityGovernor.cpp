@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.cpp
+    Created: 19 Oct 2026 2:18:40pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "QualityGovernor.h"
+
+// =============================================================================
+void QualityGovernor::prepare(const double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void QualityGovernor::reset()
+{
+    load = 0.f;
+    ceiling = QualityTier::high;
+    lastStepWasUp = false;
+    blocksOverBudget = 0;
+    secondsUnderBudget = 0.0;
+    stepUpHoldSeconds = minStepUpHoldSeconds;
+}
+
+// =============================================================================
+void QualityGovernor::addMeasurement(const double processSeconds, const int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    auto blockSeconds = numSamples / sampleRate;
+    auto blockLoad = (float) (processSeconds / blockSeconds);
+
+    load += loadSmoothing * (blockLoad - load);
+
+    // Over budget for a few blocks in a row - drop a tier
+    if (load > budget)
+    {
+        secondsUnderBudget = 0.0;
+
+        if (++blocksOverBudget >= blocksBeforeStepDown)
+            stepDown();
+
+        return;
+    }
+
+    blocksOverBudget = 0;
+
+    // Well under budget for long enough - try a tier up
+    if (load < budget * stepUpLoadRatio)
+    {
+        secondsUnderBudget += blockSeconds;
+
+        if (secondsUnderBudget >= stepUpHoldSeconds)
+            stepUp();
+    }
+    else
+    {
+        secondsUnderBudget = 0.0;
+    }
+}
+
+QualityTier QualityGovernor::limit(const QualityTier requested) const
+{
+    return juce::jmin(requested, ceiling);
+}
+
+// =============================================================================
+void QualityGovernor::stepDown()
+{
+    blocksOverBudget = 0;
+
+    if (ceiling == QualityTier::eco)
+        return;
+
+    ceiling = static_cast<QualityTier>((int) ceiling - 1);
+
+    // If the last step up didn't hold, wait longer before the next one
+    if (lastStepWasUp)
+        stepUpHoldSeconds = juce::jmin(stepUpHoldSeconds * 2.0, maxStepUpHoldSeconds);
+
+    lastStepWasUp = false;
+}
+
+void QualityGovernor::stepUp()
+{
+    secondsUnderBudget = 0.0;
+
+    if (ceiling == QualityTier::high)
+        return;
+
+    ceiling = static_cast<QualityTier>((int) ceiling + 1);
+    lastStepWasUp = true;
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.h
+    Created: 19 Oct 2026 2:18:40pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+
+// Watches how long ShitClipper::process() takes against the time the block
+// represents, and lowers the highest quality tier the engine may use when it
+// gets close to its budget. Steps back up once the load has stayed low for a
+// while, waiting longer every time a step up had to be undone.
+class QualityGovernor
+{
+public:
+    // =============================================================================
+    void prepare(const double sampleRate);
+    void reset();
+
+    // Share of each block's real time the engine is allowed to use.
+    void setBudget(const float fractionOfDeadline) { budget = fractionOfDeadline; }
+
+    // Call after every process() with the time it took.
+    void addMeasurement(const double processSeconds, const int numSamples);
+
+    // Requested tier, capped to what the current load allows.
+    QualityTier limit(const QualityTier requested) const;
+
+    QualityTier getCeiling() const { return ceiling; }
+    float getLoad() const { return load; }
+
+private:
+    //==============================================================================
+    void stepDown();
+    void stepUp();
+
+    double sampleRate = 44100.0;
+    float budget = 0.25f;
+    float load = 0.f;                   // smoothed process time / block time
+
+    QualityTier ceiling = QualityTier::high;
+    bool lastStepWasUp = false;
+
+    int blocksOverBudget = 0;
+    double secondsUnderBudget = 0.0;
+    double stepUpHoldSeconds = minStepUpHoldSeconds;
+
+    // tuning
+    static constexpr float loadSmoothing = 0.1f;
+    static constexpr int blocksBeforeStepDown = 4;
+    static constexpr float stepUpLoadRatio = 0.4f;      // of the budget
+    static constexpr double minStepUpHoldSeconds = 2.0;
+    static constexpr double maxStepUpHoldSeconds = 32.0;
+};
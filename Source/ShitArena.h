@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    ShitArena.h
+    Created: 19 Oct 2026 5:36:52pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One cache line aligned block of memory, handed out front to back. The engine
+// lays all of its real-time state and scratch space out in one of these, so an
+// instance sits in a few consecutive cache lines instead of all over the heap.
+//
+// Laying out takes two passes over the same allocate() calls. On an arena with
+// no storage they only count bytes and hand back nullptr; reserve() that many
+// and run them again for the real pointers.
+class ShitArena
+{
+public:
+    static constexpr size_t alignment = 64;
+
+    // Make room for numBytes and start handing out from the front again.
+    // Everything handed out before is gone.
+    void reserve(const size_t numBytes)
+    {
+        if (numBytes > capacity)
+        {
+            storage.allocate(numBytes + alignment - 1, false);
+            auto address = reinterpret_cast<juce::pointer_sized_uint>(storage.get());
+            base = storage.get() + ((alignment - address % alignment) % alignment);
+            capacity = numBytes;
+        }
+
+        bytesUsed = 0;
+    }
+
+    // Free the storage and go back to measuring.
+    void release()
+    {
+        storage.free();
+        base = nullptr;
+        capacity = 0;
+        bytesUsed = 0;
+    }
+
+    template <typename T>
+    T* allocate(const size_t count = 1, const size_t objectAlignment = alignof(T))
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "the arena never runs destructors");
+        jassert(objectAlignment >= alignof(T) && objectAlignment <= alignment);
+
+        auto offset = (bytesUsed + objectAlignment - 1) / objectAlignment * objectAlignment;
+        bytesUsed = offset + sizeof(T) * count;
+
+        if (base == nullptr)
+            return nullptr;
+
+        jassert(bytesUsed <= capacity);
+
+        auto* objects = reinterpret_cast<T*>(base + offset);
+
+        for (size_t i = 0; i < count; ++i)
+            new (objects + i) T();
+
+        return objects;
+    }
+
+    size_t getBytesUsed() const { return bytesUsed; }
+    size_t getCapacity() const { return capacity; }
+
+private:
+    //==============================================================================
+    juce::HeapBlock<char> storage;
+    char* base = nullptr;
+    size_t capacity = 0;
+    size_t bytesUsed = 0;
+};
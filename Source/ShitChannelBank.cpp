@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    ShitChannelBank.cpp
+    Created: 19 Oct 2026 8:54:21pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "ShitChannelBank.h"
+
+ShitChannelBank::ShitChannelBank()
+{}
+
+ShitChannelBank::~ShitChannelBank()
+{}
+
+// =============================================================================
+void ShitChannelBank::prepare(const double sampleRate,
+                                const int maximumBlockSize,
+                                const int numChannels,
+                                const ChainSettings& chainSettings)
+{
+    const auto numOldEngines = juce::jmin(engines.size(), (size_t) numChannels);
+
+    while ((int) engines.size() < numChannels)
+        engines.push_back(std::make_unique<ShitClipper>());
+
+    engines.resize((size_t) numChannels);
+
+    // Every engine is mono. The tier is decided here for all of them.
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = (juce::uint32) maximumBlockSize;
+    spec.numChannels = 1;
+    spec.sampleRate = sampleRate;
+
+    for (auto& engine : engines)
+    {
+        engine->setNonRealtime(renderingOffline);
+        engine->setAdaptiveQuality(false);
+        engine->prepare(spec, sampleRate, chainSettings);
+    }
+
+    // New channels need the cabinet IR, and so do the old ones at a new rate
+    const auto sampleRateChanged = sampleRate != preparedSampleRate;
+    preparedSampleRate = sampleRate;
+
+    if (sampleRateChanged)
+    {
+        resampleCabinetIR(sampleRate);
+        sendCabinetIR(0);
+    }
+    else
+    {
+        sendCabinetIR(numOldEngines);
+    }
+
+    qualityGovernor.prepare(sampleRate);
+
+    useWorkers = numChannels >= minChannelsForWorkers && workers->pool.getNumWorkers() > 0;
+}
+
+void ShitChannelBank::process(juce::AudioBuffer<float>& buffer,
+                                const double sampleRate,
+                                const ChainSettings& chainSettings)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), (int) engines.size());
+
+    blockSettings = chainSettings;
+
+    if (adaptiveQuality && !renderingOffline)
+        blockSettings.quality = qualityGovernor.limit(chainSettings.quality);
+
+    // Grab the pointers here, so the tasks never touch the buffer object
+    channelData = buffer.getArrayOfWritePointers();
+    blockNumSamples = buffer.getNumSamples();
+    blockSampleRate = sampleRate;
+
+    if (useWorkers)
+    {
+        workers->pool.run(&ShitChannelBank::processChannelTask, this, numChannels);
+    }
+    else
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            processChannelTask(this, channel);
+    }
+
+    // The whole bus shares one deadline
+    if (adaptiveQuality && !renderingOffline)
+    {
+        auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+        qualityGovernor.addMeasurement(juce::Time::highResolutionTicksToSeconds(elapsedTicks),
+                                        blockNumSamples);
+    }
+}
+
+void ShitChannelBank::processChannelTask(void* context, int channel)
+{
+    auto& bank = *static_cast<ShitChannelBank*>(context);
+
+    // refers to the host's channel, nothing gets allocated
+    float* const channels[] = { bank.channelData[channel] };
+    juce::AudioBuffer<float> channelBuffer(channels, 1, bank.blockNumSamples);
+
+    bank.engines[(size_t) channel]->process(channelBuffer, bank.blockSampleRate, bank.blockSettings);
+}
+
+// =============================================================================
+void ShitChannelBank::setNonRealtime(const bool isNonRealtime)
+{
+    renderingOffline = isNonRealtime;
+
+    for (auto& engine : engines)
+        engine->setNonRealtime(isNonRealtime);
+}
+
+void ShitChannelBank::loadCabinetImpulseResponse(const juce::File& irFile)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(irFile));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return;
+
+    cabinetIR.setSize(1, (int) reader->lengthInSamples);
+    reader->read(&cabinetIR, 0, cabinetIR.getNumSamples(), 0, true, false);
+    cabinetIRSampleRate = reader->sampleRate;
+
+    // Not prepared yet, prepare() sends it on
+    if (preparedSampleRate <= 0.0)
+        return;
+
+    resampleCabinetIR(preparedSampleRate);
+    sendCabinetIR(0);
+}
+
+void ShitChannelBank::resampleCabinetIR(const double sampleRate)
+{
+    if (cabinetIR.getNumSamples() == 0)
+        return;
+
+    if (cabinetIRSampleRate == sampleRate)
+    {
+        resampledCabinetIR.makeCopyOf(cabinetIR);
+        return;
+    }
+
+    // The same way the convolution would have done it for every channel
+    const auto ratio = cabinetIRSampleRate / sampleRate;
+    const auto numSamples = (int) std::ceil(cabinetIR.getNumSamples() / ratio);
+
+    juce::MemoryAudioSource memorySource(cabinetIR, false);
+    juce::ResamplingAudioSource resampler(&memorySource, false, 1);
+
+    resampledCabinetIR.setSize(1, numSamples);
+    resampler.setResamplingRatio(ratio);
+    resampler.prepareToPlay(numSamples, sampleRate);
+    resampler.getNextAudioBlock(juce::AudioSourceChannelInfo(&resampledCabinetIR, 0, numSamples));
+}
+
+void ShitChannelBank::sendCabinetIR(const size_t firstChannel)
+{
+    if (resampledCabinetIR.getNumSamples() == 0)
+        return;
+
+    for (auto channel = firstChannel; channel < engines.size(); ++channel)
+    {
+        juce::AudioBuffer<float> ir;
+        ir.makeCopyOf(resampledCabinetIR);
+
+        engines[channel]->loadCabinetImpulseResponse(std::move(ir), preparedSampleRate);
+    }
+}
+
+// =============================================================================
+int ShitChannelBank::getLatencySamples() const
+{
+    // every channel runs the same chain
+    return engines.empty() ? 0 : engines.front()->getLatencySamples();
+}
+
+double ShitChannelBank::getTailLengthSeconds() const
+{
+    double tailLength = 0.0;
+
+    for (auto& engine : engines)
+        tailLength = juce::jmax(tailLength, engine->getTailLengthSeconds());
+
+    return tailLength;
+}
+
+bool ShitChannelBank::isFullyPrepared() const
+{
+    for (auto& engine : engines)
+        if (!engine->isFullyPrepared())
+            return false;
+
+    return true;
+}
+
+ShitClipper::MemoryFootprint ShitChannelBank::getMemoryFootprint() const
+{
+    ShitClipper::MemoryFootprint total;
+
+    for (auto& engine : engines)
+    {
+        auto footprint = engine->getMemoryFootprint();
+
+        total.objectBytes += footprint.objectBytes;
+        total.arenaBytes += footprint.arenaBytes;
+        total.oversamplerBytes += footprint.oversamplerBytes;
+        total.cabinetBytes += footprint.cabinetBytes;
+    }
+
+    return total;
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    ShitChannelBank.h
+    Created: 19 Oct 2026 8:54:21pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ShitClipper.h"
+#include "ShitWorkerPool.h"
+#include "QualityGovernor.h"
+
+// One ShitClipper per channel, for buses of any width. Wide buses get their
+// channels spread over a small worker pool shared by every instance in the
+// process, each worker taking whole channels so every chain still runs its
+// vectorised block kernels over the sub-block.
+// The bank picks the quality tier for all channels together, so they always
+// run the same chain.
+class ShitChannelBank
+{
+public:
+    // =============================================================================
+    ShitChannelBank();
+    ~ShitChannelBank();
+
+    // Same as ShitClipper, for a bus of numChannels channels
+    void prepare(const double sampleRate,
+                    const int maximumBlockSize,
+                    const int numChannels,
+                    const ChainSettings& chainSettings);
+    void process(juce::AudioBuffer<float>& buffer,
+                    const double sampleRate,
+                    const ChainSettings& chainSettings);
+
+    void setNonRealtime(const bool isNonRealtime);
+    void setAdaptiveQuality(const bool shouldAdapt) { adaptiveQuality = shouldAdapt; }
+    QualityGovernor& getQualityGovernor() { return qualityGovernor; }
+
+    // Goes to every channel's cabinet, and to channels added later on. The
+    // file is read and resampled once here, not once per channel.
+    void loadCabinetImpulseResponse(const juce::File& irFile);
+
+    int getNumChannels() const { return (int) engines.size(); }
+    int getNumWorkers() const { return useWorkers ? workers->pool.getNumWorkers() : 0; }
+    int getLatencySamples() const;
+    double getTailLengthSeconds() const;
+    bool isFullyPrepared() const;
+
+    // Summed over all channels
+    ShitClipper::MemoryFootprint getMemoryFootprint() const;
+
+    // Buses from this wide up get the worker pool
+    static constexpr int minChannelsForWorkers = 4;
+    static constexpr int maxWorkers = 3;
+
+private:
+    //==============================================================================
+    static void processChannelTask(void* context, int channel);
+
+    // Resample the decoded IR to the engines' rate, and hand the engines from
+    // firstChannel on a copy each
+    void resampleCabinetIR(const double sampleRate);
+    void sendCabinetIR(const size_t firstChannel);
+
+    std::vector<std::unique_ptr<ShitClipper>> engines;
+
+    // Leaves a core for the host, and the audio thread takes tasks too
+    struct SharedWorkerPool
+    {
+        SharedWorkerPool() { pool.start(juce::jlimit(0, maxWorkers, juce::SystemStats::getNumCpus() - 2)); }
+
+        ShitWorkerPool pool;
+    };
+
+    juce::SharedResourcePointer<SharedWorkerPool> workers;
+    bool useWorkers = false;
+
+    // What process() hands the tasks for the block in flight
+    float* const* channelData = nullptr;
+    int blockNumSamples = 0;
+    double blockSampleRate = 44100.0;
+    ChainSettings blockSettings;
+
+    QualityGovernor qualityGovernor;
+    bool adaptiveQuality = true;
+    bool renderingOffline = false;
+
+    // The cabinet IR as read from its file, first channel only, and at the
+    // rate the engines were last prepared at
+    juce::AudioBuffer<float> cabinetIR;
+    double cabinetIRSampleRate = 0.0;
+    juce::AudioBuffer<float> resampledCabinetIR;
+    double preparedSampleRate = 0.0;
+};
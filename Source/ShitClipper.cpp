@@ -1,263 +1,1198 @@
-/*
-  ==============================================================================
-
-    ShitClipper.cpp
-    Created: 15 Feb 2022 11:06:33pm
-    Author:  bob
-
-  ==============================================================================
-*/
-
-#include "ShitClipper.h"
-
-ShitClipper::ShitClipper()
-{}
-
-ShitClipper::~ShitClipper()
-{}
-
-// =============================================================================
-void ShitClipper::prepare(juce::dsp::ProcessSpec spec,
-                            const double sampleRate,
-                            juce::AudioProcessorValueTreeState& apvts)
-{
-    dryWet.prepare(spec);
-    wetChain.prepare(spec);
-
-    //  Get settings
-    auto chainSettings = getChainSettings(apvts);
-
-    // Initialize the wet processor chain
-    initWetChain(chainSettings, sampleRate);
-}
-
-// =============================================================================
-void ShitClipper::process(juce::AudioBuffer<float>& buffer,
-                            const double sampleRate,
-                            juce::AudioProcessorValueTreeState& apvts)
-{
-    // Get settings
-    auto chainSettings = getChainSettings(apvts);
-
-    // Cook variables
-    updateWetChain(chainSettings, sampleRate);
-
-    if (!chainSettings.isBypassed)
-    {
-        // Get block to process
-        juce::dsp::AudioBlock<float> block(buffer);
-
-        auto wetBlock = block.getSingleChannelBlock(0);
-        auto dryBlock = wetBlock; // create dry copy of block
-
-        dryWet.pushDrySamples(dryBlock);
-
-        // Create processing context for wet block
-        juce::dsp::ProcessContextReplacing<float> wetContext(wetBlock);
-
-        // Process wet block and get output
-        wetChain.process(wetContext);
-        auto processedWetBlock = wetContext.getOutputBlock();
-
-        // Mix dry and wet blocks
-        dryWet.mixWetSamples(processedWetBlock);
-    }
-}
-
-// =============================================================================
-// Initialize main processor chains.
-void ShitClipper::initWetChain(const ChainSettings& chainSettings, const double sampleRate)
-{
-    // Set wet mix proportion
-    dryWet.setWetMixProportion(0.5f);
-
-    initClipChain(chainSettings.drive, sampleRate);
-    initToneVolChain(chainSettings.tone, chainSettings.level, sampleRate);
-}
-
-void ShitClipper::initClipChain(const float drive, const double sampleRate)
-{
-    setPreGain(drive);
-    setWaveShaperFunction();
-    setPostGain();
-    setClipperLpfFreq(drive, sampleRate);
-    setClipperHpfFreq(sampleRate);
-}
-
-void ShitClipper::initToneVolChain(const float tone, const float level, const double sampleRate)
-{
-    setMainLpfFreq(sampleRate);
-    setToneHpfFreq(tone, sampleRate);
-    setToneLpfFreq(tone, sampleRate);
-    setLevelGain(level);
-}
-
-// =============================================================================
-// Update main processor chains.
-void ShitClipper::updateWetChain(const ChainSettings& chainSettings, const double sampleRate)
-{
-    updateClipChain(chainSettings.drive, sampleRate);
-    updateToneVolChain(chainSettings.tone, chainSettings.level, sampleRate);
-}
-
-void ShitClipper::updateClipChain(const float drive, const double sampleRate)
-{
-    setPreGain(drive);
-    setClipperLpfFreq(drive, sampleRate);
-}
-
-void ShitClipper::updateToneVolChain(const float tone, const float level, const double sampleRate)
-{
-    setToneHpfFreq(tone, sampleRate);
-    setToneLpfFreq(tone, sampleRate);
-    setLevelGain(level);
-}
-
-// =============================================================================
-// Clip chain methods.
-void ShitClipper::setPreGain(const float drive)
-{
-    auto preGainVal = juce::jmap<float>(drive, 0.f, 10.f, 21.f, 41.f);
-    clipChain.get<ClipChainPositions::preGain>().setGainDecibels(preGainVal);
-}
-
-void ShitClipper::setPostGain()
-{
-    // set clipper post-gain to fixed -18 dB
-    clipChain.get<ClipChainPositions::postGain>().setGainDecibels(-18.f);
-}
-
-void ShitClipper::setWaveShaperFunction()
-{
-    // set clipper waveshaping function
-    clipChain.get<ClipChainPositions::clipper>().functionToUse = [] (float x)
-    {
-        return std::tanh(x);
-    };
-}
-
-void ShitClipper::setClipperHpfFreq(double sampleRate)
-{
-    // set clipper HPF at fixed 720 Hz
-    auto clipHpfCoefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(
-        720.f,
-        sampleRate,
-        1
-    );
-
-    *clipChain.get<ClipChainPositions::Hpf>().coefficients = *clipHpfCoefficients[0];
-}
-
-void ShitClipper::setClipperLpfFreq(const float drive, const double sampleRate)
-{
-    // set clipper LPF using Drive param
-    auto clipLpfFreq = juce::jmap<float>(10.f - drive, 0.0, 10.f, 5600.f, 20000.f);
-    auto clipLpfCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
-        clipLpfFreq,
-        sampleRate,
-        1
-    );
-
-    *clipChain.get<ClipChainPositions::Lpf>().coefficients = *clipLpfCoefficients[0];
-}
-
-// =============================================================================
-// Tone - Volume chain methods.
-void ShitClipper::setMainLpfFreq(const double sampleRate)
-{
-    // set the main LPF
-    auto mainLpfCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
-        723.4f,
-        sampleRate,
-        1
-    );
-
-    *toneVolChain.get<ToneVolChainPositions::mainLpf>().coefficients = *mainLpfCoefficients[0];
-}
-
-void ShitClipper::setToneHpfFreq(const float tone, const double sampleRate)
-{
-    // sett the tone HPF with Tone param
-    auto toneHpfFreq = juce::jmap<float>(tone, 0.f, 10.f, 20.f, 2066.f);
-    auto toneHpfCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
-        toneHpfFreq,
-        sampleRate,
-        1
-    );
-
-    *toneVolChain.get<ToneVolChainPositions::toneHpf>().coefficients = *toneHpfCoefficients[0];
-}
-
-void ShitClipper::setToneLpfFreq(const float tone, const double sampleRate)
-{
-    // set the tone LPF with Tone param
-    auto toneLpfFreq = juce::jmap<float>(tone, 0.f, 10.f, 723.4f, 3200.f);
-    auto toneLpfCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
-        toneLpfFreq,
-        sampleRate,
-        1
-    );
-
-    *toneVolChain.get<ToneVolChainPositions::toneLpf>().coefficients = *toneLpfCoefficients[0];
-}
-
-void ShitClipper::setLevelGain(const float level)
-{
-    // initialize level gain with Level param
-    auto levelGainDb = juce::jmap<float>(level, 0.f, 10.f, -20.f, 20.f);
-    toneVolChain.get<ToneVolChainPositions::level>().setGainDecibels(levelGainDb);
-}
-
-// =============================================================================
-// Create plugin params
-juce::AudioProcessorValueTreeState::ParameterLayout
-    ShitClipper::createParameterLayout()
-{
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    layout.add(std::make_unique<juce::AudioParameterBool>(
-        "Bypass",
-        "Bypass",
-        false
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        "Drive",
-        "Drive",
-        juce::NormalisableRange<float>(
-            0.f, 10.f, 0.1f, 1.f),
-        5.f
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        "Tone",
-        "Tone",
-        juce::NormalisableRange<float>(
-            0.f, 10.f, 0.1f, 1.f),
-        5.f
-    ));
-
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-        "Level",
-        "Level",
-        juce::NormalisableRange<float>(
-            0.f, 10.f, 0.1f, 1.f),
-        5.f
-    ));
-
-    return layout;
-}
-
-// =============================================================================
-// Gett settings frrom plugin.
-ChainSettings ShitClipper::getChainSettings(juce::AudioProcessorValueTreeState& apvts)
-{
-    ChainSettings settings;
-
-    settings.isBypassed = apvts.getRawParameterValue("Bypass")->load();
-    settings.drive = apvts.getRawParameterValue("Drive")->load();
-    settings.tone = apvts.getRawParameterValue("Tone")->load();
-    settings.level = apvts.getRawParameterValue("Level")->load();
-
-    return settings;
-}
\ No newline at end of file
+/*
+  ==============================================================================
+
+    ShitClipper.cpp
+    Created: 15 Feb 2022 11:06:33pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "ShitClipper.h"
+
+#if POOPSMEARER_STAGE_PROFILING
+ #define SHITCLIPPER_PROFILE_STAGE(stage) \
+    const ScopedProfileStage JUCE_JOIN_MACRO(scopedProfileStage, __LINE__) (profileListener, ProfileStage::stage)
+#else
+ #define SHITCLIPPER_PROFILE_STAGE(stage)
+#endif
+
+ShitClipper::ShitClipper()
+{
+    // pick the DSP kernels for this CPU up front rather than on the audio thread
+    ShitKernels::getKernels();
+}
+
+ShitClipper::~ShitClipper()
+{}
+
+// =============================================================================
+void ShitClipper::prepare(juce::dsp::ProcessSpec spec,
+                            const double sampleRate,
+                            const ChainSettings& requestedSettings)
+{
+    auto chainSettings = getEffectiveSettings(requestedSettings);
+
+    // Everything downstream only ever sees fixed size sub-blocks
+    juce::dsp::ProcessSpec subBlockSpec { spec.sampleRate,
+                                          (juce::uint32) subBlockSize,
+                                          spec.numChannels };
+
+    cabinet.prepare(subBlockSpec);
+
+    // Whatever was built for the old rate is no use any more, and neither is
+    // anything a background prepare for it is about to hand over.
+    prepared.reset();
+
+    std::unique_ptr<PreparedState> stale;
+    int generation = 0;
+
+    {
+        const juce::SpinLock::ScopedLockType sl(mailbox->lock);
+        stale = std::move(mailbox->ready);
+        generation = ++mailbox->generation;
+    }
+
+    stale.reset();
+
+    // The latency is known up front, so the host hears about it now and the
+    // fallback can be lined up with it.
+    latencySamples = 0;
+
+    for (int tier = 0; tier < numQualityTiers; ++tier)
+        latencySamples = juce::jmax(latencySamples, getOversamplerLatency(tier));
+
+    fallback.prepare(latencySamples);
+    fallback.setSettings(chainSettings, sampleRate);
+    fallbackFadeSamplesRemaining = 0;
+
+    bypassDelayBuffer.assign((size_t) latencySamples, 0.f);
+    bypassDelay.buffer = bypassDelayBuffer.data();
+    bypassDelay.length = latencySamples;
+    bypassDelay.reset();
+    bypassed = chainSettings.isBypassed;
+    bypassFadeSamplesRemaining = 0;
+
+    fadeSamplesRemaining = 0;
+    hasPendingTier = false;
+    qualityGovernor.prepare(sampleRate);
+
+    currentSettings = chainSettings;
+    samplesUntilUpdate = subBlockSize;
+
+    // Start awake with empty filter states
+    silentSamples = 0;
+    isAsleep = false;
+
+    // Bounces can take as long as they like, so build it all right here.
+    // Otherwise leave it to the pool and let the fallback run meanwhile.
+    if (renderingOffline)
+    {
+        adoptPreparedState(buildPreparedState(sampleRate, (int) spec.numChannels), sampleRate);
+        return;
+    }
+
+    preparePool->pool.addJob([mailbox = mailbox, generation, sampleRate, numChannels = (int) spec.numChannels]
+    {
+        auto newState = buildPreparedState(sampleRate, numChannels);
+
+        const juce::SpinLock::ScopedLockType sl(mailbox->lock);
+
+        // a newer prepare() has been and gone, this one's for the old rate
+        if (mailbox->generation == generation)
+            std::swap(mailbox->ready, newState);
+    });
+}
+
+// =============================================================================
+// Background prepare.
+std::unique_ptr<ShitClipper::PreparedState> ShitClipper::buildPreparedState(const double sampleRate,
+                                                                             const int numChannels)
+{
+    auto newState = std::make_unique<PreparedState>();
+    juce::SharedResourcePointer<ShitTableCache> tableCache;
+
+    // Coefficient tables come from the process-wide cache. Ask for all the
+    // tiers before waiting on any, so missing ones get built side by side.
+    for (int tier = 0; tier < numQualityTiers; ++tier)
+        tableCache->prefetch(sampleRate, static_cast<QualityTier>(tier));
+
+    newState->toneTables = tableCache->get(sampleRate, QualityTier::eco);
+
+    // One clip path per quality tier: eco runs at the host rate, normal and
+    // high are oversampled 2x and 4x with integer latency polyphase IIR
+    // half-band filters.
+    int latency = 0;
+
+    for (int tier = 0; tier < numQualityTiers; ++tier)
+    {
+        auto& path = newState->clipPaths[(size_t) tier];
+        auto factorLog2 = (size_t) tier;
+        int pathLatency = 0;
+
+        path.oversamplingFactor = getOversamplingFactor(static_cast<QualityTier>(tier));
+        path.tables = tableCache->get(sampleRate, static_cast<QualityTier>(tier));
+
+        if (factorLog2 > 0)
+        {
+            path.oversampler = std::make_unique<Oversampler>((size_t) numChannels,
+                                                                factorLog2,
+                                                                Oversampler::filterHalfBandPolyphaseIIR,
+                                                                true,
+                                                                true);
+            path.oversampler->initProcessing((size_t) subBlockSize);
+            pathLatency = (int) path.oversampler->getLatencyInSamples();
+        }
+
+        jassert(pathLatency == getOversamplerLatency(tier));
+
+        path.latencyPad.length = pathLatency;
+        latency = juce::jmax(latency, pathLatency);
+    }
+
+    // pad every path (and the dry signal) out to the slowest one
+    for (auto& path : newState->clipPaths)
+        path.latencyPad.length = latency - path.latencyPad.length;
+
+    newState->dryDelay.length = latency;
+
+    // Now the sizes are known, lay all the real-time state out in one block:
+    // count first, then hand out for real
+    newState->layOut();
+    newState->arena.reserve(newState->arena.getBytesUsed());
+    newState->layOut();
+
+    for (auto& path : newState->clipPaths)
+        path.reset();
+
+    newState->dryDelay.reset();
+
+    return newState;
+}
+
+void ShitClipper::collectPreparedState(const double sampleRate)
+{
+    // Audio thread - never wait for the job, just look again next time
+    std::unique_ptr<PreparedState> newState;
+
+    {
+        const juce::SpinLock::ScopedTryLockType sl(mailbox->lock);
+
+        if (sl.isLocked())
+            newState = std::move(mailbox->ready);
+    }
+
+    if (newState != nullptr)
+    {
+        adoptPreparedState(std::move(newState), sampleRate);
+
+        // fade over from the fallback rather than jumping
+        fallbackFadeSamplesRemaining = fadeLengthSamples;
+    }
+}
+
+void ShitClipper::adoptPreparedState(std::unique_ptr<PreparedState> newState, const double sampleRate)
+{
+    jassert(prepared == nullptr);
+    prepared = std::move(newState);
+
+    // Initialize the wet processor chain
+    initWetChain(currentSettings, sampleRate);
+}
+
+int ShitClipper::getOversamplerLatency(const int factorLog2)
+{
+    static const auto latencies = []
+    {
+        std::array<int, numQualityTiers> result {};
+
+        for (int tier = 1; tier < numQualityTiers; ++tier)
+        {
+            Oversampler oversampler(1, (size_t) tier, Oversampler::filterHalfBandPolyphaseIIR, true, true);
+            result[(size_t) tier] = (int) oversampler.getLatencyInSamples();
+        }
+
+        return result;
+    }();
+
+    return latencies[(size_t) factorLog2];
+}
+
+// =============================================================================
+// Fallback path.
+void ShitClipper::FallbackPath::prepare(const int latency)
+{
+    delayBuffer.assign((size_t) latency, 0.f);
+    delay.buffer = delayBuffer.data();
+    delay.length = latency;
+    reset();
+}
+
+void ShitClipper::FallbackPath::reset()
+{
+    clipHpf.reset();
+    clipLpf.reset();
+
+    for (auto& filter : toneFilters)
+        filter.reset();
+
+    delay.reset();
+}
+
+void ShitClipper::FallbackPath::setSettings(const ChainSettings& chainSettings, const double sampleRate)
+{
+    // Same mappings as the full engine, designed on the spot at the host rate
+    auto preGainDb = ShitTables::getPreGainDecibels(chainSettings.drive);
+    auto levelGainDb = ShitTables::getLevelGainDecibels(chainSettings.level);
+
+    preGain = juce::Decibels::decibelsToGain(preGainDb);
+    postGain = juce::Decibels::decibelsToGain(-18.f);
+    levelGain = juce::Decibels::decibelsToGain(levelGainDb);
+    wetMixProportion = 0.5f;
+
+    clipHpf.setCoefficients(FirstOrderCoefficients::highpass(720.f, sampleRate));
+    clipLpf.setCoefficients(FirstOrderCoefficients::lowpass(ShitTables::getClipLpfFreq(chainSettings.drive),
+                                                            sampleRate));
+
+    // the tone HPF is a lowpass design in the tables too
+    toneFilters[ToneFilterPositions::mainLpf].setCoefficients(FirstOrderCoefficients::lowpass(723.4f, sampleRate));
+    toneFilters[ToneFilterPositions::toneLpf].setCoefficients(
+        FirstOrderCoefficients::lowpass(ShitTables::getToneLpfFreq(chainSettings.tone), sampleRate));
+    toneFilters[ToneFilterPositions::toneHpf].setCoefficients(
+        FirstOrderCoefficients::lowpass(ShitTables::getToneHpfFreq(chainSettings.tone), sampleRate));
+}
+
+void ShitClipper::FallbackPath::process(float* samples, int numSamples) noexcept
+{
+    auto& kernels = ShitKernels::getKernels();
+
+    std::copy(samples, samples + numSamples, dryBuffer.begin());
+
+    kernels.clipFast(samples, numSamples, preGain, postGain);
+
+    Filter* filters[] = { &clipHpf, &clipLpf, &toneFilters[0], &toneFilters[1], &toneFilters[2] };
+    kernels.filterCascade(samples, numSamples, filters, (int) std::size(filters));
+
+    kernels.applyGain(samples, numSamples, levelGain);
+    kernels.mixDryWet(samples, dryBuffer.data(), numSamples, 1.f - wetMixProportion, wetMixProportion);
+
+    // line up with the latency the full engine will have
+    delay.process(samples, numSamples);
+}
+
+// =============================================================================
+void ShitClipper::process(juce::AudioBuffer<float>& buffer,
+                            const double sampleRate,
+                            const ChainSettings& requestedSettings)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    auto chainSettings = getEffectiveSettings(requestedSettings);
+
+    // Get block to process
+    juce::dsp::AudioBlock<float> block(buffer);
+    auto monoBlock = block.getSingleChannelBlock(0);
+    const auto numSamples = (int) monoBlock.getNumSamples();
+
+    setBypassed(chainSettings.isBypassed);
+
+    if (bypassed && bypassFadeSamplesRemaining == 0)
+    {
+        // the wet path sits idle, just keep the latency
+        bypassDelay.process(monoBlock.getChannelPointer(0), numSamples);
+
+        // pick up any changes straight away once we're switched back on
+        samplesUntilUpdate = 0;
+        return;
+    }
+
+    // Walk the host buffer in fixed sub-blocks. The grid runs across host
+    // buffers, so tiny host blocks only pay for a coefficient update every
+    // subBlockSize samples, and huge ones stay cache resident.
+    for (int pos = 0; pos < numSamples;)
+    {
+        if (samplesUntilUpdate == 0)
+        {
+            // The background prepare can land at any time
+            if (prepared == nullptr)
+                collectPreparedState(sampleRate);
+
+            // Cook variables
+            if (chainSettings != currentSettings)
+            {
+                if (prepared != nullptr)
+                    updateWetChain(chainSettings, sampleRate);
+
+                if (prepared == nullptr || fallbackFadeSamplesRemaining > 0)
+                    fallback.setSettings(chainSettings, sampleRate);
+
+                currentSettings = chainSettings;
+            }
+
+            // A tier change held back by a running fade goes in once it's done
+            if (prepared != nullptr && hasPendingTier && fadeSamplesRemaining == 0)
+                updateQuality(pendingTier, sampleRate);
+
+            // The cabinet IR can finish loading at any time
+            if (prepared != nullptr)
+                updateCabinet(currentSettings.cabEnabled, sampleRate);
+
+            samplesUntilUpdate = subBlockSize;
+        }
+
+        const auto subBlockLength = juce::jmin(numSamples - pos, samplesUntilUpdate);
+        auto subBlock = monoBlock.getSubBlock((size_t) pos, (size_t) subBlockLength);
+
+        // the delayed dry signal, in case bypass gets switched on
+        auto* samples = subBlock.getChannelPointer(0);
+        std::copy(samples, samples + subBlockLength, bypassBuffer.begin());
+        bypassDelay.process(bypassBuffer.data(), subBlockLength);
+
+        processSubBlock(subBlock);
+
+        if (bypassFadeSamplesRemaining > 0)
+            crossfadeBypass(samples, subBlockLength);
+
+        pos += subBlockLength;
+        samplesUntilUpdate -= subBlockLength;
+    }
+
+    // Offline renders have no deadline to keep
+    if (adaptiveQuality && !renderingOffline)
+    {
+        auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+        qualityGovernor.addMeasurement(juce::Time::highResolutionTicksToSeconds(elapsedTicks),
+                                        numSamples);
+    }
+}
+
+void ShitClipper::setBypassed(const bool shouldBeBypassed)
+{
+    if (shouldBeBypassed == bypassed)
+        return;
+
+    // Coming back from a finished bypass, the wet path still holds whatever
+    // it had when it stopped. Start it afresh, with the dry delay it mixes
+    // in picking up from the bypass one so the dry share lines up at once.
+    if (! shouldBeBypassed && bypassFadeSamplesRemaining == 0)
+    {
+        if (prepared != nullptr)
+        {
+            for (auto* filter : prepared->toneFilters)
+                filter->reset();
+
+            for (auto& path : prepared->clipPaths)
+                path.reset();
+
+            auto& dryDelay = prepared->dryDelay;
+            jassert(dryDelay.length == bypassDelay.length);
+
+            std::copy(bypassDelay.buffer, bypassDelay.buffer + bypassDelay.length, dryDelay.buffer);
+            dryDelay.position = bypassDelay.position;
+        }
+
+        cabinet.reset();
+        fallback.reset();
+        fadeSamplesRemaining = 0;
+        fallbackFadeSamplesRemaining = 0;
+        silentSamples = 0;
+        isAsleep = false;
+    }
+
+    // a switch back mid fade turns round from where it got to
+    bypassed = shouldBeBypassed;
+    bypassFadeSamplesRemaining = fadeLengthSamples - bypassFadeSamplesRemaining;
+}
+
+void ShitClipper::crossfadeBypass(float* samples, int numSamples) noexcept
+{
+    auto getWetGain = [this]
+    {
+        auto progress = 1.f - (float) bypassFadeSamplesRemaining / fadeLengthSamples;
+        return bypassed ? 1.f - progress : progress;
+    };
+
+    auto startGain = getWetGain();
+    bypassFadeSamplesRemaining = juce::jmax(0, bypassFadeSamplesRemaining - numSamples);
+    auto endGain = getWetGain();
+
+    ShitKernels::getKernels().crossfade(samples, bypassBuffer.data(), numSamples, startGain, endGain);
+}
+
+void ShitClipper::processSubBlock(juce::dsp::AudioBlock<float>& wetBlock)
+{
+    if (prepared == nullptr)
+    {
+        fallback.process(wetBlock.getChannelPointer(0), (int) wetBlock.getNumSamples());
+        return;
+    }
+
+    auto& preparedState = *prepared;
+
+    // Skip the wet chain once the input has been silent at the output for
+    // longer than the filter tails take to decay.
+    auto& kernels = ShitKernels::getKernels();
+    auto* samples = wetBlock.getChannelPointer(0);
+    const auto numSamples = (int) wetBlock.getNumSamples();
+    const auto range = wetBlock.findMinAndMax();
+    const auto magnitude = juce::jmax(std::abs(range.getStart()), std::abs(range.getEnd()));
+
+    if (magnitude * outputPathGain < silenceThreshold)
+    {
+        silentSamples = juce::jmin(silentSamples + numSamples, tailSamples);
+
+        if (silentSamples >= tailSamples)
+        {
+            if (!isAsleep)
+            {
+                // flush whatever is left in the filters before sleeping
+                for (auto* filter : preparedState.toneFilters)
+                    filter->reset();
+
+                cabinet.reset();
+                preparedState.clipPaths[(size_t) currentTier].reset();
+                fadeSamplesRemaining = 0;
+                fallbackFadeSamplesRemaining = 0;
+                isAsleep = true;
+            }
+
+            // The wet tail has died out, so the output is just the dry share.
+            // Keep it delayed and mixed like the awake path so waking up
+            // doesn't step the level or jump in time.
+            preparedState.dryDelay.process(samples, numSamples);
+            kernels.applyGain(samples, numSamples, 1.f - preparedState.state->wetMixProportion);
+            return;
+        }
+    }
+    else
+    {
+        silentSamples = 0;
+        isAsleep = false;
+    }
+
+    // create dry copy of block
+
+    {
+        SHITCLIPPER_PROFILE_STAGE(dryWetMix);
+        std::copy(samples, samples + numSamples, preparedState.dryBuffer);
+        preparedState.dryDelay.process(preparedState.dryBuffer, numSamples);
+    }
+
+    // Just after the background prepare landed the fallback keeps running
+    // alongside, to fade out of
+    if (fallbackFadeSamplesRemaining > 0)
+    {
+        std::copy(samples, samples + numSamples, fallback.outputBuffer.begin());
+        fallback.process(fallback.outputBuffer.data(), numSamples);
+    }
+
+    // Create processing context for wet block
+    WetContext wetContext(wetBlock);
+
+    // Process wet block
+    (this->*wetKernel)(wetContext);
+
+    // Mix dry and wet blocks
+    // fully wet (stacked stages blend their own) leaves nothing to mix
+    if (preparedState.state->wetMixProportion < 1.f)
+    {
+        SHITCLIPPER_PROFILE_STAGE(dryWetMix);
+        kernels.mixDryWet(samples,
+                            preparedState.dryBuffer,
+                            numSamples,
+                            1.f - preparedState.state->wetMixProportion,
+                            preparedState.state->wetMixProportion);
+    }
+
+    if (fallbackFadeSamplesRemaining > 0)
+    {
+        auto startGain = 1.f - (float) fallbackFadeSamplesRemaining / fadeLengthSamples;
+        fallbackFadeSamplesRemaining = juce::jmax(0, fallbackFadeSamplesRemaining - numSamples);
+        auto endGain = 1.f - (float) fallbackFadeSamplesRemaining / fadeLengthSamples;
+
+        kernels.crossfade(samples, fallback.outputBuffer.data(), numSamples, startGain, endGain);
+    }
+}
+
+// =============================================================================
+// Wet path kernels.
+template <QualityTier Tier, bool UseCabinet, bool UseMultiband, bool Stacked>
+void ShitClipper::processWet(WetContext& wetContext)
+{
+    // Clip, tone filters, level and cabinet, all through the CPU specific
+    // block kernels.
+    auto& kernels = ShitKernels::getKernels();
+    auto& block = wetContext.getOutputBlock();
+
+    if (fadeSamplesRemaining > 0)
+        crossfadeClipPaths(block);
+    else
+        processClipPath<Tier, UseMultiband, Stacked>(block);
+
+    auto* samples = block.getChannelPointer(0);
+    auto numSamples = (int) block.getNumSamples();
+
+    // stacked stages did their tone - volume in the clip path already
+    if constexpr (! Stacked)
+    {
+        SHITCLIPPER_PROFILE_STAGE(toneVolume);
+
+        kernels.filterCascade(samples,
+                                numSamples,
+                                prepared->toneFilters.data(),
+                                (int) prepared->toneFilters.size());
+
+        // unity level is a no-op multiply
+        auto levelGain = prepared->state->levelGain;
+
+        if (std::abs(levelGain - 1.f) > unityGainThreshold)
+            kernels.applyGain(samples, numSamples, levelGain);
+    }
+
+    if constexpr (UseCabinet)
+    {
+        SHITCLIPPER_PROFILE_STAGE(cabinet);
+        cabinet.process(wetContext);
+    }
+}
+
+template <QualityTier Tier, bool UseMultiband, bool Stacked>
+void ShitClipper::processClipPath(juce::dsp::AudioBlock<float>& block)
+{
+    auto& path = prepared->clipPaths[(size_t) Tier];
+
+    // Clip stage, oversampled everywhere but in eco
+    if constexpr (Tier == QualityTier::eco)
+    {
+        processClip<Tier, UseMultiband, Stacked>(path, block);
+    }
+    else
+    {
+        juce::dsp::AudioBlock<float> oversampledBlock;
+
+        {
+            SHITCLIPPER_PROFILE_STAGE(oversampleUp);
+            oversampledBlock = path.oversampler->processSamplesUp(block);
+        }
+
+        processClip<Tier, UseMultiband, Stacked>(path, oversampledBlock);
+    }
+
+    SHITCLIPPER_PROFILE_STAGE(oversampleDown);
+
+    if constexpr (Tier != QualityTier::eco)
+        path.oversampler->processSamplesDown(block);
+
+    path.latencyPad.process(block.getChannelPointer(0), (int) block.getNumSamples());
+}
+
+template <QualityTier Tier, bool UseMultiband, bool Stacked>
+void ShitClipper::processClip(ClipPath& path, juce::dsp::AudioBlock<float>& block)
+{
+    SHITCLIPPER_PROFILE_STAGE(clip);
+
+    auto& kernels = ShitKernels::getKernels();
+    auto* samples = block.getChannelPointer(0);
+    auto numSamples = (int) block.getNumSamples();
+
+    if constexpr (! Stacked)
+    {
+        auto& clipState = *path.state;
+        processShaper<Tier, UseMultiband>(path, clipState, samples, numSamples);
+
+        Filter* clipFilters[] = { &clipState.hpf, &clipState.lpf };
+
+        kernels.filterCascade(samples, numSamples, clipFilters, 2);
+    }
+    else
+    {
+        // The oversampled sub-block goes through every stage in turn while it
+        // sits in cache, one up and down sampling for the whole stack.
+        auto* dry = prepared->stageDryBuffer;
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            auto& stageState = path.stages[stage];
+            auto& clipState = stageState.clip;
+
+            std::copy(samples, samples + numSamples, dry);
+
+            // only the first stage splits into bands
+            if (stage == 0)
+                processShaper<Tier, UseMultiband>(path, clipState, samples, numSamples);
+            else
+                processShaper<Tier, false>(path, clipState, samples, numSamples);
+
+            Filter* stageFilters[] = { &clipState.hpf,
+                                       &clipState.lpf,
+                                       &stageState.toneFilters[ToneFilterPositions::mainLpf],
+                                       &stageState.toneFilters[ToneFilterPositions::toneLpf],
+                                       &stageState.toneFilters[ToneFilterPositions::toneHpf] };
+
+            kernels.filterCascade(samples, numSamples, stageFilters, (int) std::size(stageFilters));
+
+            if (std::abs(stageState.levelGain - 1.f) > unityGainThreshold)
+                kernels.applyGain(samples, numSamples, stageState.levelGain);
+
+            kernels.mixDryWet(samples,
+                                dry,
+                                numSamples,
+                                1.f - stageState.wetMixProportion,
+                                stageState.wetMixProportion);
+        }
+    }
+}
+
+template <QualityTier Tier, bool UseMultiband>
+void ShitClipper::processShaper(ClipPath& path, ClipState& clipState, float* samples, int numSamples)
+{
+    auto& kernels = ShitKernels::getKernels();
+
+    // The multiband clip runs the fast tanh in every tier, the bands only
+    // vectorise without a transcendental call in the loop.
+    if constexpr (UseMultiband)
+        kernels.multibandClip(samples, numSamples, *path.multiband, clipState.postGain);
+    else if constexpr (Tier == QualityTier::eco)
+        kernels.clipFast(samples, numSamples, clipState.preGain, clipState.postGain);
+    else if constexpr (Tier == QualityTier::normal)
+        kernels.clip(samples, numSamples, clipState.preGain, clipState.postGain);
+    else
+        kernels.clipAdaa(samples, numSamples, clipState.preGain, clipState.postGain,
+                            clipState.adaaState);
+
+    juce::ignoreUnused(path);
+}
+
+void ShitClipper::crossfadeClipPaths(juce::dsp::AudioBlock<float>& block)
+{
+    auto* samples = block.getChannelPointer(0);
+    auto numSamples = (int) block.getNumSamples();
+
+    // old tier on a copy, new tier in place
+    auto* fadeBuffer = prepared->fadeBuffer;
+    std::copy(samples, samples + numSamples, fadeBuffer);
+
+    float* fadeChannels[] = { fadeBuffer };
+    juce::dsp::AudioBlock<float> fadeBlock(fadeChannels, 1, (size_t) numSamples);
+
+    auto options = (multibandEnabled ? 2 : 0) + (numStages > 1 ? 1 : 0);
+
+    (this->*clipKernels[(size_t) fadingOutTier * 4 + (size_t) options])(fadeBlock);
+    (this->*clipKernels[(size_t) currentTier * 4 + (size_t) options])(block);
+
+    auto startGain = 1.f - (float) fadeSamplesRemaining / fadeLengthSamples;
+    fadeSamplesRemaining = juce::jmax(0, fadeSamplesRemaining - numSamples);
+    auto endGain = 1.f - (float) fadeSamplesRemaining / fadeLengthSamples;
+
+    ShitKernels::getKernels().crossfade(samples, fadeBuffer, numSamples, startGain, endGain);
+}
+
+// Every combination of the options, in index order
+template <size_t... Index>
+constexpr std::array<ShitClipper::ClipKernel, sizeof...(Index)> ShitClipper::makeClipKernels(std::index_sequence<Index...>)
+{
+    return { &ShitClipper::processClipPath<static_cast<QualityTier>(Index / 4),
+                                            (Index / 2) % 2 == 1,
+                                            Index % 2 == 1>... };
+}
+
+template <size_t... Index>
+constexpr std::array<ShitClipper::WetKernel, sizeof...(Index)> ShitClipper::makeWetKernels(std::index_sequence<Index...>)
+{
+    return { &ShitClipper::processWet<static_cast<QualityTier>(Index / 8),
+                                        (Index / 4) % 2 == 1,
+                                        (Index / 2) % 2 == 1,
+                                        Index % 2 == 1>... };
+}
+
+const std::array<ShitClipper::ClipKernel, numQualityTiers * 4> ShitClipper::clipKernels
+    = makeClipKernels(std::make_index_sequence<numQualityTiers * 4>());
+
+const std::array<ShitClipper::WetKernel, numQualityTiers * 8> ShitClipper::wetKernels
+    = makeWetKernels(std::make_index_sequence<numQualityTiers * 8>());
+
+void ShitClipper::selectWetKernel()
+{
+    auto index = (((size_t) currentTier * 2 + (cabIRSize > 0 ? 1 : 0)) * 2
+                    + (multibandEnabled ? 1 : 0)) * 2
+                    + (numStages > 1 ? 1 : 0);
+
+    wetKernel = wetKernels[index];
+}
+
+void ShitClipper::ClipPath::reset()
+{
+    if (oversampler != nullptr)
+        oversampler->reset();
+
+    for (int stage = 0; stage < maxStages; ++stage)
+    {
+        auto& stageState = stages[stage];
+
+        stageState.clip.hpf.reset();
+        stageState.clip.lpf.reset();
+        stageState.clip.adaaState = 0.f;
+
+        for (auto& filter : stageState.toneFilters)
+            filter.reset();
+    }
+
+    multiband->reset();
+    latencyPad.reset();
+}
+
+// =============================================================================
+// Real-time state layout.
+void ShitClipper::PreparedState::layOut()
+{
+    // Hot first: the state every sample touches, then the scratch buffers,
+    // then the delay lines which only see one read and write per sample.
+    state = arena.allocate<RealtimeState>();
+    dryBuffer = arena.allocate<float>(subBlockSize, ShitArena::alignment);
+    fadeBuffer = arena.allocate<float>(subBlockSize, ShitArena::alignment);
+    stageDryBuffer = arena.allocate<float>((size_t) (subBlockSize * getOversamplingFactor(QualityTier::high)),
+                                            ShitArena::alignment);
+    dryDelay.buffer = arena.allocate<float>((size_t) dryDelay.length);
+
+    for (auto& path : clipPaths)
+        path.latencyPad.buffer = arena.allocate<float>((size_t) path.latencyPad.length);
+
+    if (state == nullptr)
+        return;
+
+    for (int tier = 0; tier < numQualityTiers; ++tier)
+    {
+        auto& path = clipPaths[(size_t) tier];
+
+        path.stages = state->stages[(size_t) tier].data();
+        path.state = &path.stages[0].clip;
+        path.multiband = &state->multiband[(size_t) tier];
+    }
+
+    toneFilters = { &state->toneFilters[ToneFilterPositions::mainLpf],
+                    &state->toneFilters[ToneFilterPositions::toneLpf],
+                    &state->toneFilters[ToneFilterPositions::toneHpf] };
+}
+
+// =============================================================================
+// Initialize main processor chains.
+void ShitClipper::initWetChain(const ChainSettings& chainSettings, const double sampleRate)
+{
+    // Set wet mix proportion
+    prepared->state->wetMixProportion = 0.5f;
+
+    currentTier = chainSettings.quality;
+    hasPendingTier = false;
+
+    initClipChain(chainSettings.drive, sampleRate);
+    setMultiband(chainSettings, sampleRate);
+    initToneVolChain(chainSettings.tone, chainSettings.level, sampleRate);
+    setStages(chainSettings, sampleRate);
+
+    // Cabinet stays bypassed until an IR is actually running
+    cabIRSize = 0;
+    selectWetKernel();
+    updateCabinet(chainSettings.cabEnabled, sampleRate);
+
+    updateTailLength(sampleRate);
+}
+
+void ShitClipper::initClipChain(const float drive, const double sampleRate)
+{
+    setPreGain(drive);
+    setPostGain();
+    setClipperLpfFreq(drive, sampleRate);
+    setClipperHpfFreq(sampleRate);
+}
+
+void ShitClipper::initToneVolChain(const float tone, const float level, const double sampleRate)
+{
+    setMainLpfFreq(sampleRate);
+    setToneHpfFreq(tone, sampleRate);
+    setToneLpfFreq(tone, sampleRate);
+    setLevelGain(level);
+}
+
+// =============================================================================
+// Update main processor chains.
+void ShitClipper::updateWetChain(const ChainSettings& chainSettings, const double sampleRate)
+{
+    updateClipChain(chainSettings.drive, sampleRate);
+    setMultiband(chainSettings, sampleRate);
+    updateToneVolChain(chainSettings.tone, chainSettings.level, sampleRate);
+    setStages(chainSettings, sampleRate);
+    updateQuality(chainSettings.quality, sampleRate);
+
+    selectWetKernel();
+    updateTailLength(sampleRate);
+}
+
+void ShitClipper::updateClipChain(const float drive, const double sampleRate)
+{
+    setPreGain(drive);
+    setClipperLpfFreq(drive, sampleRate);
+}
+
+void ShitClipper::updateToneVolChain(const float tone, const float level, const double sampleRate)
+{
+    setToneHpfFreq(tone, sampleRate);
+    setToneLpfFreq(tone, sampleRate);
+    setLevelGain(level);
+}
+
+void ShitClipper::updateQuality(const QualityTier quality, const double sampleRate)
+{
+    // a later change replaces one still waiting
+    hasPendingTier = false;
+
+    if (quality == currentTier)
+        return;
+
+    // Let a running fade finish first, jumping the half faded in path to full
+    // or nothing would click. process() has another go once it's done.
+    if (fadeSamplesRemaining > 0)
+    {
+        pendingTier = quality;
+        hasPendingTier = true;
+        return;
+    }
+
+    // start the new path from silence rather than from whatever it held
+    // the last time it ran, and fade over to it from the current one
+    prepared->clipPaths[(size_t) quality].reset();
+    fadingOutTier = currentTier;
+    fadeSamplesRemaining = fadeLengthSamples;
+    currentTier = quality;
+
+    selectWetKernel();
+    updateTailLength(sampleRate);
+}
+
+ChainSettings ShitClipper::getEffectiveSettings(const ChainSettings& chainSettings) const
+{
+    // Bounces always get the top tier, whatever is picked for tracking
+    auto effectiveSettings = chainSettings;
+
+    if (renderingOffline)
+        effectiveSettings.quality = QualityTier::high;
+    else if (adaptiveQuality)
+        effectiveSettings.quality = qualityGovernor.limit(chainSettings.quality);
+
+    return effectiveSettings;
+}
+
+// =============================================================================
+// Clip chain methods. Every quality tier has its own clip chain, so these set
+// all of them.
+void ShitClipper::setPreGain(const float drive)
+{
+    auto preGainVal = ShitTables::getPreGainDecibels(drive);
+
+    for (auto& path : prepared->clipPaths)
+        path.state->preGain = juce::Decibels::decibelsToGain(preGainVal);
+}
+
+void ShitClipper::setPostGain()
+{
+    // set clipper post-gain to fixed -18 dB
+    for (auto& path : prepared->clipPaths)
+        path.state->postGain = juce::Decibels::decibelsToGain(-18.f);
+}
+
+void ShitClipper::setMultiband(const ChainSettings& chainSettings, const double sampleRate)
+{
+    // set the band split and each band's drive, Drive plus the band's trim
+    auto preGainVal = ShitTables::getPreGainDecibels(chainSettings.drive);
+
+    multibandEnabled = chainSettings.numBands > 1;
+
+    for (auto& path : prepared->clipPaths)
+    {
+        auto& multiband = *path.multiband;
+
+        if (multiband.numBands != chainSettings.numBands)
+            multiband.setBands(chainSettings.numBands, sampleRate * path.oversamplingFactor);
+
+        for (int band = 0; band < maxClipBands; ++band)
+            multiband.setBandGain(band,
+                                    juce::Decibels::decibelsToGain(preGainVal + chainSettings.bandTrims[(size_t) band]));
+    }
+}
+
+void ShitClipper::setStages(const ChainSettings& chainSettings, const double sampleRate)
+{
+    // Stacked stages get their clip and tone - volume at each clip path's
+    // rate. The first stage's clip is the plain clip stage, set above.
+    juce::ignoreUnused(sampleRate);
+
+    auto newNumStages = juce::jlimit(1, maxStages, chainSettings.numStages);
+
+    // the blend happens inside every stage instead of once at the end
+    prepared->state->wetMixProportion = newNumStages > 1 ? 1.f : 0.5f;
+
+    for (auto& path : prepared->clipPaths)
+    {
+        for (int stage = 0; stage < newNumStages; ++stage)
+        {
+            auto& stageState = path.stages[stage];
+            auto& tables = *path.tables;
+
+            auto stageSettings = stage == 0 ? StageSettings { chainSettings.drive, chainSettings.tone, chainSettings.level }
+                                            : chainSettings.stackedStages[(size_t) stage - 1];
+
+            // stages coming in start from silence
+            if (stage >= numStages)
+            {
+                stageState.clip.hpf.reset();
+                stageState.clip.lpf.reset();
+                stageState.clip.adaaState = 0.f;
+
+                for (auto& filter : stageState.toneFilters)
+                    filter.reset();
+            }
+
+            if (stage > 0)
+            {
+                stageState.clip.preGain = juce::Decibels::decibelsToGain(ShitTables::getPreGainDecibels(stageSettings.drive));
+                stageState.clip.postGain = juce::Decibels::decibelsToGain(-18.f);
+                stageState.clip.hpf.setCoefficients(tables.clipHpf);
+                stageState.clip.lpf.setCoefficients(tables.getClipLpf(stageSettings.drive));
+            }
+
+            stageState.toneFilters[ToneFilterPositions::mainLpf].setCoefficients(tables.mainLpf);
+            stageState.toneFilters[ToneFilterPositions::toneLpf].setCoefficients(tables.getToneLpf(stageSettings.tone));
+            stageState.toneFilters[ToneFilterPositions::toneHpf].setCoefficients(tables.getToneHpf(stageSettings.tone));
+            stageState.levelGain = juce::Decibels::decibelsToGain(ShitTables::getLevelGainDecibels(stageSettings.level));
+            stageState.wetMixProportion = 0.5f;
+        }
+    }
+
+    numStages = newNumStages;
+}
+
+void ShitClipper::setClipperHpfFreq(double sampleRate)
+{
+    // set clipper HPF at fixed 720 Hz
+    juce::ignoreUnused(sampleRate);
+
+    for (auto& path : prepared->clipPaths)
+        path.state->hpf.setCoefficients(path.tables->clipHpf);
+}
+
+void ShitClipper::setClipperLpfFreq(const float drive, const double sampleRate)
+{
+    // set clipper LPF using Drive param
+    juce::ignoreUnused(sampleRate);
+
+    for (auto& path : prepared->clipPaths)
+        path.state->lpf.setCoefficients(path.tables->getClipLpf(drive));
+}
+
+// =============================================================================
+// Tone - Volume chain methods. The filters come out of the shared tables,
+// which are designed for the rate passed to prepare().
+void ShitClipper::setMainLpfFreq(const double sampleRate)
+{
+    // set the main LPF
+    jassert(prepared->toneTables->sampleRate == sampleRate);
+    juce::ignoreUnused(sampleRate);
+
+    prepared->toneFilters[ToneFilterPositions::mainLpf]->setCoefficients(prepared->toneTables->mainLpf);
+}
+
+void ShitClipper::setToneHpfFreq(const float tone, const double sampleRate)
+{
+    // sett the tone HPF with Tone param
+    juce::ignoreUnused(sampleRate);
+    prepared->toneFilters[ToneFilterPositions::toneHpf]->setCoefficients(prepared->toneTables->getToneHpf(tone));
+}
+
+void ShitClipper::setToneLpfFreq(const float tone, const double sampleRate)
+{
+    // set the tone LPF with Tone param
+    juce::ignoreUnused(sampleRate);
+    prepared->toneFilters[ToneFilterPositions::toneLpf]->setCoefficients(prepared->toneTables->getToneLpf(tone));
+}
+
+void ShitClipper::setLevelGain(const float level)
+{
+    // initialize level gain with Level param
+    auto levelGainDb = ShitTables::getLevelGainDecibels(level);
+    prepared->state->levelGain = juce::Decibels::decibelsToGain(levelGainDb);
+}
+
+// =============================================================================
+// Cabinet IR methods.
+void ShitClipper::loadCabinetImpulseResponse(const juce::File& irFile)
+{
+    cabinet.loadImpulseResponse(irFile,
+                                juce::dsp::Convolution::Stereo::no,
+                                juce::dsp::Convolution::Trim::yes,
+                                0,
+                                juce::dsp::Convolution::Normalise::yes);
+}
+
+void ShitClipper::loadCabinetImpulseResponse(const void* irData, size_t irDataSize)
+{
+    cabinet.loadImpulseResponse(irData,
+                                irDataSize,
+                                juce::dsp::Convolution::Stereo::no,
+                                juce::dsp::Convolution::Trim::yes,
+                                0,
+                                juce::dsp::Convolution::Normalise::yes);
+}
+
+// Already decoded, so a bank of engines can share one read of the file. An IR
+// at the engine's own rate skips the convolution's resampling too.
+void ShitClipper::loadCabinetImpulseResponse(juce::AudioBuffer<float>&& ir, const double irSampleRate)
+{
+    cabinet.loadImpulseResponse(std::move(ir),
+                                irSampleRate,
+                                juce::dsp::Convolution::Stereo::no,
+                                juce::dsp::Convolution::Trim::yes,
+                                juce::dsp::Convolution::Normalise::yes);
+}
+
+void ShitClipper::updateCabinet(const bool cabEnabled, const double sampleRate)
+{
+    // only run the convolution once there's an IR loaded to run
+    auto newIRSize = cabEnabled ? cabinet.getCurrentIRSize() : 0;
+
+    if (newIRSize != cabIRSize)
+    {
+        cabIRSize = newIRSize;
+        selectWetKernel();
+        updateTailLength(sampleRate);
+    }
+}
+
+// =============================================================================
+// Silence detection / tail length.
+int ShitClipper::getFilterTailSamples(const Filter& filter)
+{
+    // All filters in the chain are first order with a single pole. The
+    // impulse response decays as |pole|^n, so solve |pole|^n = threshold for n.
+    auto pole = std::abs(filter.getPole());
+
+    if (pole < 1.0e-6f)
+        return 1;
+
+    jassert(pole < 1.f);
+
+    return (int) std::ceil(std::log(silenceThreshold) / std::log(pole));
+}
+
+void ShitClipper::updateTailLength(const double sampleRate)
+{
+    // The worst case gain from input to output decides how quiet the input
+    // has to be before we can call it silence.
+    auto& state = *prepared->state;
+    auto& path = prepared->clipPaths[(size_t) currentTier];
+    auto& clipState = *path.state;
+    auto& toneFilters = prepared->toneFilters;
+
+    auto preGain = clipState.preGain;
+
+    // Summing the per-filter tails is a safe upper bound for the cascade. The
+    // clip filters count in oversampled samples.
+    auto clipTailSamples = getFilterTailSamples(clipState.hpf)
+                            + getFilterTailSamples(clipState.lpf);
+
+    // The bands each have their own drive and crossover tail
+    if (multibandEnabled)
+    {
+        preGain = 0.f;
+
+        for (auto bandGain : path.multiband->preGain)
+            preGain += bandGain;
+
+        clipTailSamples += path.multiband->getTailSamples(silenceThreshold);
+    }
+
+    wetPathGain = preGain * clipState.postGain * state.levelGain;
+
+    // Stacked stages each blend their dry signal back in, and their tone
+    // filters run at the clip path's rate too
+    if (numStages > 1)
+    {
+        wetPathGain = 1.f;
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            auto& stageState = path.stages[stage];
+            auto stagePreGain = stage == 0 ? preGain : stageState.clip.preGain;
+
+            wetPathGain *= 1.f - stageState.wetMixProportion
+                            + stageState.wetMixProportion * stagePreGain * stageState.clip.postGain
+                                * stageState.levelGain;
+
+            if (stage > 0)
+                clipTailSamples += getFilterTailSamples(stageState.clip.hpf)
+                                    + getFilterTailSamples(stageState.clip.lpf);
+
+            for (auto& filter : stageState.toneFilters)
+                clipTailSamples += getFilterTailSamples(filter);
+        }
+    }
+
+    // The dry signal mixes back in around the wet path, so the output sees both
+    outputPathGain = 1.f - state.wetMixProportion + state.wetMixProportion * wetPathGain;
+
+    tailSamples = clipTailSamples / path.oversamplingFactor
+                    + latencySamples
+                    + getFilterTailSamples(*toneFilters[ToneFilterPositions::mainLpf])
+                    + getFilterTailSamples(*toneFilters[ToneFilterPositions::toneLpf])
+                    + getFilterTailSamples(*toneFilters[ToneFilterPositions::toneHpf])
+                    + cabIRSize;
+
+    tailLengthSeconds.store(tailSamples / sampleRate);
+}
+
+double ShitClipper::getTailLengthSeconds() const
+{
+    return tailLengthSeconds.load();
+}
+
+// =============================================================================
+#if POOPSMEARER_STAGE_PROFILING
+const char* ShitClipper::getProfileStageName(ProfileStage stage)
+{
+    switch (stage)
+    {
+        case ProfileStage::oversampleUp:        return "oversample up";
+        case ProfileStage::clip:                return "clip";
+        case ProfileStage::oversampleDown:      return "oversample down";
+        case ProfileStage::toneVolume:          return "tone / volume";
+        case ProfileStage::cabinet:             return "cabinet";
+        case ProfileStage::dryWetMix:           return "dry / wet mix";
+        case ProfileStage::numProfileStages:    break;
+    }
+
+    return "";
+}
+#endif
+
+// =============================================================================
+ShitClipper::MemoryFootprint ShitClipper::getMemoryFootprint() const
+{
+    MemoryFootprint footprint;
+
+    footprint.objectBytes = sizeof(ShitClipper);
+    footprint.arenaBytes = fallback.delayBuffer.size() * sizeof(float);
+
+    if (prepared != nullptr)
+    {
+        footprint.arenaBytes += prepared->arena.getCapacity();
+
+        // Each oversampling stage keeps a buffer of its output, one sub-block
+        // at that stage's rate.
+        for (auto& path : prepared->clipPaths)
+            for (int factor = 2; factor <= path.oversamplingFactor; factor *= 2)
+                footprint.oversamplerBytes += sizeof(float) * (size_t) (subBlockSize * factor);
+    }
+
+    // The convolution keeps the IR spectrum (complex, so two floats a sample)
+    // and about as much input history again.
+    footprint.cabinetBytes = sizeof(float) * 4 * (size_t) cabinet.getCurrentIRSize();
+
+    return footprint;
+}
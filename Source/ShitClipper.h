@@ -1,112 +1,437 @@
-/*
-  ==============================================================================
-
-    ShitClipper.h
-    Created: 15 Feb 2022 11:06:33pm
-    Author:  bob
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-struct ChainSettings
-{
-    bool isBypassed = false;
-    float drive { 0 }, tone { 0 }, level { 0 };
-};
-
-class ShitClipper
-{
-public:
-    // =============================================================================
-    ShitClipper();
-    ~ShitClipper();
-
-    // Main methods to be called in plugin prepareToPlay() and processBlock()
-    // methods.
-    void prepare(juce::dsp::ProcessSpec spec,
-                    const double sampleRate,
-                    juce::AudioProcessorValueTreeState& apvts);
-    void process(juce::AudioBuffer<float>& buffer,
-                    const double sampleRate,
-                    juce::AudioProcessorValueTreeState& apvts);
-
-    // Inittialize main processor chains.
-    void initWetChain(const ChainSettings& chainSettings, const double sampleRate);
-    void initClipChain(const float drive, const double sampleRate);
-    void initToneVolChain(const float tone, const float level, const double sampleRate);
-    
-    // Update main processor chains.
-    void updateWetChain(const ChainSettings& chainSettings, const double sampleRate);
-    void updateClipChain(const float drive, const double sampleRate);
-    void updateToneVolChain(const float tone, const float level, const double sampleRate);
-
-    // Clip chain methods.
-    void setPreGain(const float drive);
-    void setPostGain();
-    void setWaveShaperFunction();
-    void setClipperHpfFreq(const double sampleRate);
-    void setClipperLpfFreq(const float drive, const double sampleRate);
-
-    // Tone - Volume chain methods.
-    void setMainLpfFreq(const double sampleRate);
-    void setToneHpfFreq(const float tone, const double sampleRate);
-    void setToneLpfFreq(const float tone, const double sampleRate);
-    void setLevelGain(const float level);
-
-    // Parameter setup to be used when creating APVTS in plugin.
-    static juce::AudioProcessorValueTreeState::ParameterLayout
-        createParameterLayout();
-
-    // Get settings from APVTS
-    ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
-
-    // aliases
-    using DryWet = juce::dsp::DryWetMixer<float>;
-    using Gain = juce::dsp::Gain<float>;
-    using Filter = juce::dsp::IIR::Filter<float>;
-    using WaveShaper = juce::dsp::WaveShaper<float>;
-
-    using ClipChain = juce::dsp::ProcessorChain<Gain, WaveShaper, Gain, Filter, Filter>;
-    using ToneVolChain = juce::dsp::ProcessorChain<Filter, Filter, Filter, Gain>;
-    using WetChain = juce::dsp::ProcessorChain<ClipChain, ToneVolChain>;
-
-private:
-    //==============================================================================
-    // signal splitter
-    DryWet dryWet;
-
-    // Main processor chain
-    WetChain wetChain;
-
-    // chain position enums - define processor chain order
-    enum ClipChainPositions
-    {
-        preGain,
-        clipper,
-        postGain,
-        Hpf,
-        Lpf
-    };
-
-    enum ToneVolChainPositions
-    {
-        mainLpf,
-        toneLpf,
-        toneHpf,
-        level
-    };
-
-    enum WetChainPositions
-    {
-        ClipChainIndex,
-        ToneVolChainIndex
-    };
-
-    // Processor sub-chains
-    ClipChain& clipChain = wetChain.get<WetChainPositions::ClipChainIndex>();
-    ToneVolChain& toneVolChain = wetChain.get<WetChainPositions::ToneVolChainIndex>();
+/*
+  ==============================================================================
+
+    ShitClipper.h
+    Created: 15 Feb 2022 11:06:33pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+#include "ShitKernels.h"
+#include "ShitTables.h"
+#include "ShitArena.h"
+#include "ShitMultiband.h"
+#include "QualityGovernor.h"
+
+// Profiling builds (the benchmark) can have the engine report where each
+// chain stage starts and ends. Compiled out everywhere else.
+#ifndef POOPSMEARER_STAGE_PROFILING
+ #define POOPSMEARER_STAGE_PROFILING 0
+#endif
+
+class ShitClipper
+{
+public:
+    // =============================================================================
+    ShitClipper();
+    ~ShitClipper();
+
+    // Main methods to be called in plugin prepareToPlay() and processBlock()
+    // methods. Driven by plain settings rather than the APVTS, so the engine
+    // builds without the plugin and GUI modules - see ShitParameters for
+    // reading them out of the plugin's parameters.
+    //
+    // prepare() only does the cheap part itself. The tables, oversamplers and
+    // state get built on a background thread while a simple non-oversampled
+    // path stands in, then crossfaded to. After setNonRealtime(true) it builds
+    // everything before returning instead.
+    void prepare(juce::dsp::ProcessSpec spec,
+                    const double sampleRate,
+                    const ChainSettings& chainSettings);
+    void process(juce::AudioBuffer<float>& buffer,
+                    const double sampleRate,
+                    const ChainSettings& chainSettings);
+
+    // Inittialize main processor chains.
+    void initWetChain(const ChainSettings& chainSettings, const double sampleRate);
+    void initClipChain(const float drive, const double sampleRate);
+    void initToneVolChain(const float tone, const float level, const double sampleRate);
+    
+    // Update main processor chains.
+    void updateWetChain(const ChainSettings& chainSettings, const double sampleRate);
+    void updateClipChain(const float drive, const double sampleRate);
+    void updateToneVolChain(const float tone, const float level, const double sampleRate);
+    void updateQuality(const QualityTier quality, const double sampleRate);
+
+    // Offline renders always run at the highest quality tier.
+    void setNonRealtime(const bool isNonRealtime) { renderingOffline = isNonRealtime; }
+
+    // While running in real time, let the engine drop below the selected tier
+    // when process() gets close to its share of the block deadline.
+    void setAdaptiveQuality(const bool shouldAdapt) { adaptiveQuality = shouldAdapt; }
+    QualityGovernor& getQualityGovernor() { return qualityGovernor; }
+
+    // Latency of the wet path, the same for every tier.
+    int getLatencySamples() const { return latencySamples; }
+
+    // False while the fallback path is standing in for the full engine
+    bool isFullyPrepared() const { return prepared != nullptr; }
+
+    // Clip chain methods.
+    void setPreGain(const float drive);
+    void setPostGain();
+    void setMultiband(const ChainSettings& chainSettings, const double sampleRate);
+    void setStages(const ChainSettings& chainSettings, const double sampleRate);
+    void setClipperHpfFreq(const double sampleRate);
+    void setClipperLpfFreq(const float drive, const double sampleRate);
+
+    // Tone - Volume chain methods.
+    void setMainLpfFreq(const double sampleRate);
+    void setToneHpfFreq(const float tone, const double sampleRate);
+    void setToneLpfFreq(const float tone, const double sampleRate);
+    void setLevelGain(const float level);
+
+    // Cabinet IR methods. Loading happens on the convolution's own background
+    // thread and is swapped in with a crossfade, so these are safe to call
+    // from the message thread while audio is running.
+    void loadCabinetImpulseResponse(const juce::File& irFile);
+    void loadCabinetImpulseResponse(const void* irData, size_t irDataSize);
+    void loadCabinetImpulseResponse(juce::AudioBuffer<float>&& ir, const double irSampleRate);
+    void updateCabinet(const bool cabEnabled, const double sampleRate);
+
+    // Silence detection / tail length.
+    void updateTailLength(const double sampleRate);
+    double getTailLengthSeconds() const;
+    bool isSleeping() const { return isAsleep; }
+
+    // Memory held by one engine. The oversampler and cabinet figures are
+    // estimates, JUCE owns those allocations.
+    struct MemoryFootprint
+    {
+        size_t objectBytes = 0;         // the ShitClipper object itself
+        size_t arenaBytes = 0;          // real-time state and scratch buffers
+        size_t oversamplerBytes = 0;
+        size_t cabinetBytes = 0;
+
+        size_t getTotalBytes() const
+        {
+            return objectBytes + arenaBytes + oversamplerBytes + cabinetBytes;
+        }
+    };
+
+    MemoryFootprint getMemoryFootprint() const;
+
+    // aliases
+    using Filter = FirstOrderFilter;
+
+    // Internal processing granularity, independent of the host buffer size.
+    static constexpr int subBlockSize = 64;
+
+    // Speaker cabinet - non-uniform partitioned convolution with a zero
+    // latency direct head one sub-block long. Every instance in the process
+    // loads its IRs through one shared background queue instead of starting a
+    // thread of its own.
+    struct CabinetLoadQueue
+    {
+        juce::SharedResourcePointer<juce::dsp::ConvolutionMessageQueue> loadQueue;
+    };
+
+    struct Cabinet : private CabinetLoadQueue, juce::dsp::Convolution
+    {
+        Cabinet() : juce::dsp::Convolution(NonUniform { subBlockSize }, loadQueue.getObject())
+        {}
+    };
+
+    using Oversampler = juce::dsp::Oversampling<float>;
+
+   #if POOPSMEARER_STAGE_PROFILING
+    enum class ProfileStage
+    {
+        oversampleUp,
+        clip,               // clipper and clip filters, and any stacked stages
+        oversampleDown,     // including the latency padding
+        toneVolume,
+        cabinet,
+        dryWetMix,          // dry copy and delay, and the mix
+        numProfileStages
+    };
+
+    // Told about every stage of every sub-block, on the audio thread
+    struct ProfileListener
+    {
+        virtual ~ProfileListener() = default;
+        virtual void stageStarted(ProfileStage stage) = 0;
+        virtual void stageFinished(ProfileStage stage) = 0;
+    };
+
+    void setProfileListener(ProfileListener* newListener) { profileListener = newListener; }
+
+    static const char* getProfileStageName(ProfileStage stage);
+   #endif
+
+private:
+    //==============================================================================
+    void processSubBlock(juce::dsp::AudioBlock<float>& wetBlock);
+    ChainSettings getEffectiveSettings(const ChainSettings& chainSettings) const;
+
+    // Wet path kernels. Each one is specialised at compile time on the options
+    // that are switched on, and the right one is picked from the dispatch
+    // table whenever those options change, so the hot path never tests them.
+    using WetContext = juce::dsp::ProcessContextReplacing<float>;
+    using WetKernel = void (ShitClipper::*)(WetContext&);
+
+    template <QualityTier Tier, bool UseCabinet, bool UseMultiband, bool Stacked>
+    void processWet(WetContext& wetContext);
+
+    template <size_t... Index>
+    static constexpr std::array<WetKernel, sizeof...(Index)> makeWetKernels(std::index_sequence<Index...>);
+
+    void selectWetKernel();
+
+    // indexed by ((quality tier * 2 + UseCabinet) * 2 + UseMultiband) * 2 + Stacked
+    static const std::array<WetKernel, numQualityTiers * 8> wetKernels;
+    WetKernel wetKernel = &ShitClipper::processWet<QualityTier::normal, false, false, false>;
+    bool multibandEnabled = false;
+    int numStages = 1;
+
+    // Settings the chain was last cooked with and samples left until the next
+    // point on the sub-block grid where parameter changes get picked up.
+    ChainSettings currentSettings;
+    int samplesUntilUpdate = 0;
+
+    //==============================================================================
+    // Real-time state. Everything the wet path reads or writes per sample lives
+    // in the arena, laid out with the hottest fields first.
+    struct ClipState
+    {
+        float preGain = 1.f;
+        float postGain = 1.f;
+        float adaaState = 0.f;
+        Filter hpf, lpf;
+    };
+
+    // One pedal of a stack, at a clip path's rate. With stages stacked the
+    // whole series runs inside the clip path's oversampled block, each stage
+    // blending its own dry signal back in like a separate instance would.
+    struct StageState
+    {
+        ClipState clip;
+        std::array<Filter, 3> toneFilters;      // mainLpf, toneLpf, toneHpf
+        float levelGain = 1.f;
+        float wetMixProportion = 0.5f;
+    };
+
+    struct alignas(ShitArena::alignment) RealtimeState
+    {
+        std::array<Filter, 3> toneFilters;      // mainLpf, toneLpf, toneHpf
+        float levelGain = 1.f;
+        float wetMixProportion = 0.5f;
+
+        // per quality tier, the first stage's clip is the plain clip stage
+        std::array<std::array<StageState, maxStages>, numQualityTiers> stages;
+        std::array<MultibandClipState, numQualityTiers> multiband;
+    };
+
+    //==============================================================================
+    // A level within this of unity is left out rather than multiplied by
+    static constexpr float unityGainThreshold = 1.0e-3f;        // -60 dB
+
+    // Clip stage, one per quality tier. Each has its own oversampler and its
+    // filters designed for its own rate, and is padded out to the latency of
+    // the slowest tier so switching tiers doesn't shift the signal.
+    struct ClipPath
+    {
+        std::unique_ptr<Oversampler> oversampler;   // null when not oversampling
+        ClipState* state = nullptr;                 // in the arena
+        StageState* stages = nullptr;               // maxStages of them, state is the first one's
+        MultibandClipState* multiband = nullptr;
+        DelayRing latencyPad;
+        int oversamplingFactor = 1;
+
+        ShitTableCache::TablesPtr tables;           // at this path's rate
+
+        void reset();
+    };
+
+    // Everything prepare() builds for a given rate that's too slow to build
+    // on the host's thread: the coefficient tables, the oversamplers and the
+    // state arena. Built on a background thread and handed over to the audio
+    // thread once it's done.
+    struct PreparedState
+    {
+        ShitArena arena;
+        RealtimeState* state = nullptr;
+
+        // Dry copy of the current sub-block, delayed to line up with the wet
+        // path, and scratch for crossfades
+        float* dryBuffer = nullptr;
+        float* fadeBuffer = nullptr;
+        DelayRing dryDelay;
+
+        // Each stacked stage's dry signal, at the highest clip path rate
+        float* stageDryBuffer = nullptr;
+
+        std::array<ClipPath, numQualityTiers> clipPaths;
+
+        // The tone filters in processing order, for the fused filter cascade
+        // kernel. toneTables is at the host rate.
+        std::array<Filter*, 3> toneFilters {};
+        ShitTableCache::TablesPtr toneTables;
+
+        void layOut();
+    };
+
+    static std::unique_ptr<PreparedState> buildPreparedState(const double sampleRate,
+                                                             const int numChannels);
+
+    // Where a background prepare drops its result. Shared with the job, so a
+    // job finishing after the engine has gone, or after a newer prepare(),
+    // has somewhere harmless to put it.
+    struct PrepareMailbox
+    {
+        juce::SpinLock lock;
+        std::unique_ptr<PreparedState> ready;
+        int generation = 0;
+    };
+
+    struct PrepareThreadPool
+    {
+        juce::ThreadPool pool { 2 };
+    };
+
+    void collectPreparedState(const double sampleRate);
+    void adoptPreparedState(std::unique_ptr<PreparedState> newState, const double sampleRate);
+
+    std::unique_ptr<PreparedState> prepared;    // null until the background prepare lands
+    std::shared_ptr<PrepareMailbox> mailbox = std::make_shared<PrepareMailbox>();
+    juce::SharedResourcePointer<PrepareThreadPool> preparePool;
+
+    // Keeps the table cache alive between prepares while any engine exists
+    juce::SharedResourcePointer<ShitTableCache> tableCache;
+
+    // Oversampler latency only depends on the filter design, so it's known
+    // before the oversamplers are built.
+    static int getOversamplerLatency(const int factorLog2);
+
+    //==============================================================================
+    // Stand-in for the full engine until the background prepare lands: the eco
+    // clip at the host rate, its filters worked out on the spot from the
+    // bilinear transform, delayed to the latency the host was told about.
+    struct FallbackPath
+    {
+        float preGain = 1.f;
+        float postGain = 1.f;
+        float levelGain = 1.f;
+        float wetMixProportion = 0.5f;
+        Filter clipHpf, clipLpf;
+        std::array<Filter, 3> toneFilters;      // mainLpf, toneLpf, toneHpf
+
+        std::vector<float> delayBuffer;
+        DelayRing delay;
+
+        std::array<float, subBlockSize> dryBuffer;
+        std::array<float, subBlockSize> outputBuffer;
+
+        void prepare(const int latency);
+        void reset();
+        void setSettings(const ChainSettings& chainSettings, const double sampleRate);
+        void process(float* samples, int numSamples) noexcept;
+    };
+
+    FallbackPath fallback;
+    int fallbackFadeSamplesRemaining = 0;
+
+    //==============================================================================
+    // Bypass still owes the host the latency it was told about, so the input
+    // always runs through a delay of its own, ready to fade over to.
+    std::vector<float> bypassDelayBuffer;
+    DelayRing bypassDelay;
+    std::array<float, subBlockSize> bypassBuffer;
+
+    bool bypassed = false;
+    int bypassFadeSamplesRemaining = 0;
+
+    void setBypassed(const bool shouldBeBypassed);
+    void crossfadeBypass(float* samples, int numSamples) noexcept;
+
+    //==============================================================================
+    template <QualityTier Tier, bool UseMultiband, bool Stacked>
+    void processClipPath(juce::dsp::AudioBlock<float>& block);
+
+    template <QualityTier Tier, bool UseMultiband, bool Stacked>
+    void processClip(ClipPath& path, juce::dsp::AudioBlock<float>& block);
+
+    template <QualityTier Tier, bool UseMultiband>
+    void processShaper(ClipPath& path, ClipState& clipState, float* samples, int numSamples);
+
+    // Tier changes run the old and new clip paths side by side and crossfade
+    void crossfadeClipPaths(juce::dsp::AudioBlock<float>& block);
+
+    using ClipKernel = void (ShitClipper::*)(juce::dsp::AudioBlock<float>&);
+
+    template <size_t... Index>
+    static constexpr std::array<ClipKernel, sizeof...(Index)> makeClipKernels(std::index_sequence<Index...>);
+
+    // indexed by (quality tier * 2 + UseMultiband) * 2 + Stacked
+    static const std::array<ClipKernel, numQualityTiers * 4> clipKernels;
+
+    static constexpr int fadeLengthSamples = 4 * subBlockSize;
+
+    QualityTier currentTier = QualityTier::normal;
+    QualityTier fadingOutTier = QualityTier::normal;
+    int fadeSamplesRemaining = 0;
+
+    // held back until the running fade finishes
+    QualityTier pendingTier = QualityTier::normal;
+    bool hasPendingTier = false;
+
+    QualityGovernor qualityGovernor;
+    bool adaptiveQuality = true;
+    bool renderingOffline = false;
+    int latencySamples = 0;
+
+    // Speaker cabinet, after the tone - volume stage
+    Cabinet cabinet;
+
+    // tone filter order - define processing order
+    enum ToneFilterPositions
+    {
+        mainLpf,
+        toneLpf,
+        toneHpf
+    };
+
+    // Length of the IR currently running in the cabinet, 0 when bypassed
+    int cabIRSize = 0;
+
+    //==============================================================================
+    // Sleep mode - anything below -100 dB at the output counts as silence
+    static constexpr float silenceThreshold = 1.0e-5f;
+
+    static int getFilterTailSamples(const Filter& filter);
+
+    float wetPathGain = 1.f;            // linear gain from input to wet output
+    float outputPathGain = 1.f;         // the same, with the dry signal mixed in
+    int tailSamples = 0;                // samples for the IIR tails to die out
+    int silentSamples = 0;              // consecutive silent input samples seen
+    bool isAsleep = false;
+    std::atomic<double> tailLengthSeconds { 0.0 };
+
+   #if POOPSMEARER_STAGE_PROFILING
+    struct ScopedProfileStage
+    {
+        ScopedProfileStage(ProfileListener* stageListener, ProfileStage profileStage)
+            : listener(stageListener), stage(profileStage)
+        {
+            if (listener != nullptr)
+                listener->stageStarted(stage);
+        }
+
+        ~ScopedProfileStage()
+        {
+            if (listener != nullptr)
+                listener->stageFinished(stage);
+        }
+
+        ProfileListener* listener;
+        ProfileStage stage;
+    };
+
+    ProfileListener* profileListener = nullptr;
+   #endif
 };
\ No newline at end of file
@@ -0,0 +1,355 @@
+/*
+  ==============================================================================
+
+    ShitKernels.cpp
+    Created: 19 Oct 2026 10:41:12am
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "ShitKernels.h"
+#include "ShitMultiband.h"
+
+// GCC and Clang can build single functions for a wider instruction set than
+// the rest of the file. Anywhere else we only get the baseline variant.
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #define SHITKERNELS_HAS_ISA_VARIANTS 1
+#else
+ #define SHITKERNELS_HAS_ISA_VARIANTS 0
+#endif
+
+namespace ShitKernels
+{
+namespace
+{
+    // =============================================================================
+    // Kernel bodies. Force-inlined into the per-ISA entry points below, so each
+    // copy gets compiled and vectorised for that instruction set.
+    forcedinline void applyGainImpl(float* data, int numSamples, float gain) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] *= gain;
+    }
+
+    template <typename Shaper>
+    forcedinline void clipImpl(float* data, int numSamples, float preGain, float postGain) noexcept
+    {
+        Shaper shaper;
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = shaper(data[i] * preGain) * postGain;
+    }
+
+    // log(cosh(x)), the antiderivative of tanh, written so it can't overflow
+    forcedinline double logCosh(double x) noexcept
+    {
+        constexpr double ln2 = 0.69314718055994530942;
+
+        auto absX = std::abs(x);
+        return absX + std::log1p(std::exp(-2.0 * absX)) - ln2;
+    }
+
+    forcedinline void clipAdaaImpl(float* data, int numSamples, float preGain, float postGain,
+                                    float& lastInput) noexcept
+    {
+        // y[n] = (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]). Done in double, the
+        // difference of two large logCosh values is too coarse in float.
+        double x1 = lastInput;
+        double f1 = logCosh(x1);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            double x = data[i] * preGain;
+            double f = logCosh(x);
+            double dx = x - x1;
+
+            // fall back to the midpoint when the difference gets ill-conditioned
+            auto y = std::abs(dx) < 1.0e-5 ? std::tanh(0.5 * (x + x1))
+                                           : (f - f1) / dx;
+
+            data[i] = (float) y * postGain;
+            x1 = x;
+            f1 = f;
+        }
+
+        lastInput = (float) x1;
+    }
+
+    forcedinline void multibandClipImpl(float* data, int numSamples, MultibandClipState& state,
+                                        float postGain) noexcept
+    {
+        constexpr int numLanes = MultibandClipState::numLanes;
+        constexpr int numSections = MultibandClipState::numSections;
+
+        // Every inner loop runs across the band lanes with a fixed trip count,
+        // so each one turns into a single vector operation.
+        alignas(16) float z1[numSections][numLanes];
+        alignas(16) float z2[numSections][numLanes];
+
+        std::copy(&state.z1[0][0], &state.z1[0][0] + numSections * numLanes, &z1[0][0]);
+        std::copy(&state.z2[0][0], &state.z2[0][0] + numSections * numLanes, &z2[0][0]);
+
+        FastTanhShaper shaper;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            alignas(16) float x[numLanes];
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                x[lane] = data[i];
+
+            for (int s = 0; s < numSections; ++s)
+            {
+                for (int lane = 0; lane < numLanes; ++lane)
+                {
+                    auto y = state.b0[s][lane] * x[lane] + z1[s][lane];
+                    z1[s][lane] = state.b1[s][lane] * x[lane] - state.a1[s][lane] * y + z2[s][lane];
+                    z2[s][lane] = state.b2[s][lane] * x[lane] - state.a2[s][lane] * y;
+                    x[lane] = y;
+                }
+            }
+
+            float sum = 0.f;
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                sum += shaper(x[lane] * state.preGain[lane]);
+
+            data[i] = sum * postGain;
+        }
+
+        std::copy(&z1[0][0], &z1[0][0] + numSections * numLanes, &state.z1[0][0]);
+        std::copy(&z2[0][0], &z2[0][0] + numSections * numLanes, &state.z2[0][0]);
+    }
+
+    forcedinline void filterCascadeImpl(float* data, int numSamples,
+                                        FirstOrderFilter* const* filters, int numFilters) noexcept
+    {
+        jassert(numFilters <= maxCascadeLength);
+
+        // Pull everything into locals so the compiler can keep the whole
+        // cascade in registers for the sample loop.
+        float b0[maxCascadeLength], b1[maxCascadeLength], a1[maxCascadeLength], z[maxCascadeLength];
+
+        for (int f = 0; f < numFilters; ++f)
+        {
+            b0[f] = filters[f]->b0;
+            b1[f] = filters[f]->b1;
+            a1[f] = filters[f]->a1;
+            z[f] = filters[f]->z;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = data[i];
+
+            for (int f = 0; f < numFilters; ++f)
+            {
+                auto y = b0[f] * x + z[f];
+                z[f] = b1[f] * x - a1[f] * y;
+                x = y;
+            }
+
+            data[i] = x;
+        }
+
+        for (int f = 0; f < numFilters; ++f)
+            filters[f]->z = z[f];
+    }
+
+    forcedinline void mixDryWetImpl(float* wet, const float* dry, int numSamples,
+                                    float dryGain, float wetGain) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            wet[i] = dry[i] * dryGain + wet[i] * wetGain;
+    }
+
+    forcedinline void crossfadeImpl(float* to, const float* from, int numSamples,
+                                    float startGain, float endGain) noexcept
+    {
+        auto gainStep = (endGain - startGain) / (float) numSamples;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto gain = startGain + gainStep * (float) i;
+            to[i] = from[i] + (to[i] - from[i]) * gain;
+        }
+    }
+
+    // Converted a tile at a time, one of the widest vectors' worth of floats,
+    // so the byte shuffling in the fixed length inner loop vectorises
+    template <bool BigEndian>
+    forcedinline float int24SampleToFloat(const juce::uint8* bytes) noexcept
+    {
+        auto value = BigEndian ? ((juce::uint32) bytes[0] << 24) | ((juce::uint32) bytes[1] << 16) | ((juce::uint32) bytes[2] << 8)
+                               : ((juce::uint32) bytes[2] << 24) | ((juce::uint32) bytes[1] << 16) | ((juce::uint32) bytes[0] << 8);
+
+        return (float) ((juce::int32) value >> 8) * (1.f / 8388608.f);
+    }
+
+    template <bool BigEndian>
+    forcedinline void int24ToFloatImpl(const juce::uint8* source, int sourceStride, float* destination,
+                                        int numSamples) noexcept
+    {
+        constexpr int tileSize = 16;
+        int i = 0;
+
+        for (; i + tileSize <= numSamples; i += tileSize)
+            for (int j = 0; j < tileSize; ++j)
+                destination[i + j] = int24SampleToFloat<BigEndian>(source + (i + j) * sourceStride);
+
+        for (; i < numSamples; ++i)
+            destination[i] = int24SampleToFloat<BigEndian>(source + i * sourceStride);
+    }
+
+    // =============================================================================
+    // Per-ISA entry points and their kernel tables.
+   #define SHITKERNELS_DEFINE_VARIANT(isaName, targetAttribute)                                  \
+    namespace isaName                                                                           \
+    {                                                                                           \
+        targetAttribute void applyGain(float* data, int numSamples, float gain) noexcept        \
+        {                                                                                       \
+            applyGainImpl(data, numSamples, gain);                                              \
+        }                                                                                       \
+                                                                                                \
+        targetAttribute void clip(float* data, int numSamples,                                  \
+                                    float preGain, float postGain) noexcept                     \
+        {                                                                                       \
+            clipImpl<TanhShaper>(data, numSamples, preGain, postGain);                          \
+        }                                                                                       \
+                                                                                                \
+        targetAttribute void clipFast(float* data, int numSamples,                              \
+                                        float preGain, float postGain) noexcept                 \
+        {                                                                                       \
+            clipImpl<FastTanhShaper>(data, numSamples, preGain, postGain);                      \
+        }                                                                                       \
+                                                                                                \
+        targetAttribute void clipAdaa(float* data, int numSamples,                              \
+                                        float preGain, float postGain,                          \
+                                        float& lastInput) noexcept                              \
+        {                                                                                       \
+            clipAdaaImpl(data, numSamples, preGain, postGain, lastInput);                       \
+        }                                                                                       \
+                                                                                                \
+        targetAttribute void multibandClip(float* data, int numSamples,                         \
+                                            MultibandClipState& state,                          \
+                                            float postGain) noexcept                            \
+        {                                                                                       \
+            multibandClipImpl(data, numSamples, state, postGain);                               \
+        }                                                                                       \
+                                                                                                \
+        targetAttribute void filterCascade(float* data, int numSamples,                         \
+                                            FirstOrderFilter* const* filters,                   \
+                                            int numFilters) noexcept                            \
+        {                                                                                       \
+            filterCascadeImpl(data, numSamples, filters, numFilters);                           \
+        }                                                                                       \
+                                                                                                \
+        targetAttribute void mixDryWet(float* wet, const float* dry, int numSamples,            \
+                                        float dryGain, float wetGain) noexcept                  \
+        {                                                                                       \
+            mixDryWetImpl(wet, dry, numSamples, dryGain, wetGain);                              \
+        }                                                                                       \
+                                                                                                \
+        targetAttribute void crossfade(float* to, const float* from, int numSamples,            \
+                                        float startGain, float endGain) noexcept                \
+        {                                                                                       \
+            crossfadeImpl(to, from, numSamples, startGain, endGain);                            \
+        }                                                                                       \
+                                                                                                \
+        targetAttribute void int24ToFloat(const juce::uint8* source, int sourceStride,          \
+                                            float* destination, int numSamples,                 \
+                                            bool isBigEndian) noexcept                          \
+        {                                                                                       \
+            if (isBigEndian)                                                                    \
+                int24ToFloatImpl<true>(source, sourceStride, destination, numSamples);          \
+            else                                                                                \
+                int24ToFloatImpl<false>(source, sourceStride, destination, numSamples);         \
+        }                                                                                       \
+                                                                                                \
+        const Kernels kernels { applyGain, clip, clipFast, clipAdaa, multibandClip,             \
+                                filterCascade, mixDryWet, crossfade, int24ToFloat,              \
+                                Isa::isaName };                                                 \
+    }
+
+    SHITKERNELS_DEFINE_VARIANT(baseline, )
+
+   #if SHITKERNELS_HAS_ISA_VARIANTS
+    SHITKERNELS_DEFINE_VARIANT(avx2, __attribute__((target("avx2,fma"))))
+    SHITKERNELS_DEFINE_VARIANT(avx512, __attribute__((target("avx512f,avx512vl,avx2,fma"))))
+   #endif
+
+   #undef SHITKERNELS_DEFINE_VARIANT
+
+    // =============================================================================
+    const Kernels& getKernelsFor(Isa isa)
+    {
+       #if SHITKERNELS_HAS_ISA_VARIANTS
+        switch (isa)
+        {
+            case Isa::avx512:   return avx512::kernels;
+            case Isa::avx2:     return avx2::kernels;
+            case Isa::baseline: break;
+        }
+       #else
+        juce::ignoreUnused(isa);
+       #endif
+
+        return baseline::kernels;
+    }
+
+    Isa getInitialIsa()
+    {
+        auto bestIsa = getBestSupportedIsa();
+        auto requested = juce::SystemStats::getEnvironmentVariable("POOPSMEARER_ISA", {});
+
+        for (auto isa : { Isa::baseline, Isa::avx2, Isa::avx512 })
+            if (requested.equalsIgnoreCase(getIsaName(isa)))
+                return juce::jmin(isa, bestIsa);
+
+        return bestIsa;
+    }
+
+    std::atomic<const Kernels*>& getCurrentKernels()
+    {
+        static std::atomic<const Kernels*> currentKernels { &getKernelsFor(getInitialIsa()) };
+        return currentKernels;
+    }
+}
+
+// =============================================================================
+const Kernels& getKernels() noexcept
+{
+    return *getCurrentKernels().load(std::memory_order_relaxed);
+}
+
+Isa getBestSupportedIsa()
+{
+   #if SHITKERNELS_HAS_ISA_VARIANTS
+    if (juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512VL())
+        return Isa::avx512;
+
+    if (juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3())
+        return Isa::avx2;
+   #endif
+
+    return Isa::baseline;
+}
+
+void setIsaOverride(Isa isa)
+{
+    getCurrentKernels().store(&getKernelsFor(juce::jmin(isa, getBestSupportedIsa())));
+}
+
+const char* getIsaName(Isa isa)
+{
+    switch (isa)
+    {
+        case Isa::avx512:   return "avx512";
+        case Isa::avx2:     return "avx2";
+        case Isa::baseline: break;
+    }
+
+    return "baseline";
+}
+}
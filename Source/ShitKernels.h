@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    ShitKernels.h
+    Created: 19 Oct 2026 10:41:12am
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Clipper transfer function. A functor rather than a function pointer so the
+// wave shaper loop can inline it.
+struct TanhShaper
+{
+    float operator()(float x) const noexcept
+    {
+        return std::tanh(x);
+    }
+};
+
+// Cheap rational tanh, x (27 + x^2) / (27 + 9 x^2). Meets +/-1 exactly at
+// |x| = 3 and is clamped beyond, so it stays continuous. Within about 2% of
+// tanh, and has no transcendental calls so the clip loop vectorises.
+struct FastTanhShaper
+{
+    float operator()(float x) const noexcept
+    {
+        x = juce::jlimit(-3.f, 3.f, x);
+        auto x2 = x * x;
+        return x * (27.f + x2) / (27.f + 9.f * x2);
+    }
+};
+
+// Coefficients of a first order section, normalised so a0 = 1.
+struct FirstOrderCoefficients
+{
+    float b0 = 1.f, b1 = 0.f, a1 = 0.f;
+
+    static FirstOrderCoefficients fromIIR(const juce::dsp::IIR::Coefficients<float>& iirCoefficients)
+    {
+        jassert(iirCoefficients.getFilterOrder() == 1);
+
+        return { iirCoefficients.coefficients[0],
+                 iirCoefficients.coefficients[1],
+                 iirCoefficients.coefficients[2] };
+    }
+
+    // Butterworth sections straight from the bilinear transform, the same
+    // coefficients JUCE's first order designs come out with but without the
+    // allocations.
+    static FirstOrderCoefficients lowpass(const float freq, const double sampleRate) noexcept
+    {
+        auto n = (float) std::tan(juce::MathConstants<double>::pi * freq / sampleRate);
+        return { n / (n + 1.f), n / (n + 1.f), (n - 1.f) / (n + 1.f) };
+    }
+
+    static FirstOrderCoefficients highpass(const float freq, const double sampleRate) noexcept
+    {
+        auto n = (float) std::tan(juce::MathConstants<double>::pi * freq / sampleRate);
+        return { 1.f / (n + 1.f), -1.f / (n + 1.f), (n - 1.f) / (n + 1.f) };
+    }
+};
+
+// First order IIR section in transposed direct form II. Plain data, so the
+// filter cascade kernel can run a whole series of them in one pass. The
+// engine lays them out in its arena and resets them itself.
+struct FirstOrderFilter
+{
+    // y[n] = b0 * x[n] + b1 * x[n-1] - a1 * y[n-1]
+    float b0 = 1.f, b1 = 0.f, a1 = 0.f;
+    float z = 0.f;
+
+    void setCoefficients(const FirstOrderCoefficients& newCoefficients) noexcept
+    {
+        b0 = newCoefficients.b0;
+        b1 = newCoefficients.b1;
+        a1 = newCoefficients.a1;
+    }
+
+    void setCoefficients(const juce::dsp::IIR::Coefficients<float>& newCoefficients)
+    {
+        setCoefficients(FirstOrderCoefficients::fromIIR(newCoefficients));
+    }
+
+    float getPole() const noexcept { return -a1; }
+
+    void reset() noexcept { z = 0.f; }
+
+    float processSample(float x) noexcept
+    {
+        auto y = b0 * x + z;
+        z = b1 * x - a1 * y;
+        return y;
+    }
+};
+
+// Whole-sample delay on a ring buffer someone else owns (the engine's arena).
+// A length of 0 passes straight through.
+struct DelayRing
+{
+    float* buffer = nullptr;
+    int length = 0;
+    int position = 0;
+
+    void reset() noexcept
+    {
+        std::fill(buffer, buffer + length, 0.f);
+        position = 0;
+    }
+
+    void process(float* samples, int numSamples) noexcept
+    {
+        if (length == 0)
+            return;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto delayed = buffer[position];
+            buffer[position] = samples[i];
+            samples[i] = delayed;
+
+            if (++position == length)
+                position = 0;
+        }
+    }
+};
+
+struct MultibandClipState;
+
+// Block kernels for the wet path, built for several instruction sets. The best
+// set the CPU supports is picked once at load time, all variants compute the
+// same thing.
+namespace ShitKernels
+{
+    enum class Isa
+    {
+        baseline,       // SSE2 on x86-64, whatever the compiler targets elsewhere
+        avx2,
+        avx512
+    };
+
+    // Longest filter cascade filterCascade() can run in one pass
+    static constexpr int maxCascadeLength = 8;
+
+    struct Kernels
+    {
+        void (*applyGain)(float* data, int numSamples, float gain) noexcept;
+        void (*clip)(float* data, int numSamples, float preGain, float postGain) noexcept;
+        void (*clipFast)(float* data, int numSamples, float preGain, float postGain) noexcept;
+
+        // First order antiderivative anti-aliased tanh. lastInput carries the
+        // previous (pre-gained) input sample between blocks.
+        void (*clipAdaa)(float* data, int numSamples, float preGain, float postGain,
+                            float& lastInput) noexcept;
+
+        // Crossover, per band pre-gain and clip for all the bands of a
+        // MultibandClipState at once, summed back into data.
+        void (*multibandClip)(float* data, int numSamples, MultibandClipState& state,
+                                float postGain) noexcept;
+        void (*filterCascade)(float* data, int numSamples,
+                                FirstOrderFilter* const* filters, int numFilters) noexcept;
+        void (*mixDryWet)(float* wet, const float* dry, int numSamples,
+                            float dryGain, float wetGain) noexcept;
+
+        // Linear crossfade from 'from' into 'to', in place in 'to'. The gain of
+        // 'to' ramps from startGain to endGain over the block.
+        void (*crossfade)(float* to, const float* from, int numSamples,
+                            float startGain, float endGain) noexcept;
+
+        // Packed 24 bit PCM to float, for offline renders reading files in
+        // place. sourceStride is the bytes from one sample to the next, so it
+        // can pick one channel out of interleaved data.
+        void (*int24ToFloat)(const juce::uint8* source, int sourceStride, float* destination,
+                                int numSamples, bool isBigEndian) noexcept;
+
+        Isa isa;
+    };
+
+    // Kernels for the selected instruction set. Selected on first use from the
+    // CPUID flags, or from the POOPSMEARER_ISA environment variable if set.
+    const Kernels& getKernels() noexcept;
+
+    // Best instruction set this build and CPU can run.
+    Isa getBestSupportedIsa();
+
+    // Force a given instruction set, e.g. to compare variants in tests. Asking
+    // for more than the CPU supports falls back to the best supported one.
+    void setIsaOverride(Isa isa);
+
+    const char* getIsaName(Isa isa);
+}
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+    ShitMultiband.cpp
+    Created: 19 Oct 2026 8:05:31pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "ShitMultiband.h"
+
+namespace
+{
+    struct Biquad
+    {
+        float b0 = 1.f, b1 = 0.f, b2 = 0.f, a1 = 0.f, a2 = 0.f;
+    };
+
+    enum class Response
+    {
+        lowpass,
+        highpass,
+        allpass
+    };
+
+    constexpr double butterworthQ = 0.70710678118654752;
+
+    // Butterworth Q sections from the usual bilinear transform recipes, worked
+    // out here rather than through IIR::Coefficients so it doesn't allocate
+    Biquad design(const Response response, const float freq, const double sampleRate)
+    {
+        const auto w0 = juce::MathConstants<double>::twoPi * freq / sampleRate;
+        const auto cosW0 = std::cos(w0);
+        const auto alpha = std::sin(w0) / (2.0 * butterworthQ);
+        const auto a0 = 1.0 + alpha;
+
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+
+        switch (response)
+        {
+            case Response::lowpass:
+                b0 = b2 = (1.0 - cosW0) * 0.5;
+                b1 = 1.0 - cosW0;
+                break;
+
+            case Response::highpass:
+                b0 = b2 = (1.0 + cosW0) * 0.5;
+                b1 = -(1.0 + cosW0);
+                break;
+
+            case Response::allpass:
+                b0 = 1.0 - alpha;
+                b1 = -2.0 * cosW0;
+                b2 = 1.0 + alpha;
+                break;
+        }
+
+        return { (float) (b0 / a0), (float) (b1 / a0), (float) (b2 / a0),
+                 (float) (-2.0 * cosW0 / a0), (float) ((1.0 - alpha) / a0) };
+    }
+
+    float getPoleRadius(const float a1, const float a2)
+    {
+        // roots of z^2 + a1 z + a2
+        auto discriminant = a1 * a1 - 4.f * a2;
+
+        if (discriminant < 0.f)
+            return std::sqrt(a2);
+
+        auto root = std::sqrt(discriminant);
+        return juce::jmax(std::abs(-a1 + root), std::abs(-a1 - root)) * 0.5f;
+    }
+}
+
+// =============================================================================
+MultibandClipState::MultibandClipState()
+{
+    setBands(1, 44100.0);
+}
+
+void MultibandClipState::setBands(const int newNumBands, const double sampleRate)
+{
+    numBands = juce::jlimit(1, maxBands, newNumBands);
+    const auto crossovers = getCrossoverFrequencies(numBands);
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        for (int crossover = 0; crossover < maxBands - 1; ++crossover)
+        {
+            // Two sections per crossover: LR4 low or high is a Butterworth
+            // biquad twice, the allpass only needs the first of them.
+            Biquad first, second;
+
+            if (lane < numBands && crossover < numBands - 1)
+            {
+                auto freq = crossovers[(size_t) crossover];
+
+                if (lane == crossover)
+                    first = second = design(Response::lowpass, freq, sampleRate);
+                else if (lane > crossover)
+                    first = second = design(Response::highpass, freq, sampleRate);
+                else
+                    first = design(Response::allpass, freq, sampleRate);
+            }
+
+            for (auto [section, biquad] : { std::make_pair(2 * crossover, first),
+                                            std::make_pair(2 * crossover + 1, second) })
+            {
+                b0[section][lane] = biquad.b0;
+                b1[section][lane] = biquad.b1;
+                b2[section][lane] = biquad.b2;
+                a1[section][lane] = biquad.a1;
+                a2[section][lane] = biquad.a2;
+            }
+        }
+
+        if (lane >= numBands)
+            preGain[lane] = 0.f;
+    }
+
+    reset();
+}
+
+void MultibandClipState::setBandGain(const int band, const float gain) noexcept
+{
+    jassert(band >= 0 && band < maxBands);
+    preGain[band] = band < numBands ? gain : 0.f;
+}
+
+void MultibandClipState::reset() noexcept
+{
+    for (int section = 0; section < numSections; ++section)
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            z1[section][lane] = 0.f;
+            z2[section][lane] = 0.f;
+        }
+    }
+}
+
+int MultibandClipState::getTailSamples(const float threshold) const
+{
+    // slowest band, each section's decay added up like the other filter tails
+    int tail = 0;
+
+    for (int lane = 0; lane < numBands; ++lane)
+    {
+        int laneTail = 0;
+
+        for (int section = 0; section < numSections; ++section)
+        {
+            auto radius = getPoleRadius(a1[section][lane], a2[section][lane]);
+
+            if (radius > 1.0e-6f)
+                laneTail += (int) std::ceil(std::log(threshold) / std::log(radius));
+        }
+
+        tail = juce::jmax(tail, laneTail);
+    }
+
+    return tail;
+}
+
+std::array<float, MultibandClipState::maxBands - 1> MultibandClipState::getCrossoverFrequencies(const int numBands)
+{
+    switch (numBands)
+    {
+        case 2:     return { 300.f, 0.f, 0.f };
+        case 3:     return { 200.f, 1600.f, 0.f };
+        case 4:     return { 150.f, 600.f, 2400.f };
+        default:    break;
+    }
+
+    return { 0.f, 0.f, 0.f };
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    ShitMultiband.h
+    Created: 19 Oct 2026 8:05:31pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+
+// Multiband clip stage. Linkwitz-Riley crossovers split the signal into up to
+// four bands, each with its own drive into the clipper, and the bands are
+// summed again afterwards.
+//
+// Every band runs in its own lane: band k goes through the same number of
+// biquad sections as every other band, just with its own coefficients, so
+// the multibandClip() kernel runs all the bands in one register width. The
+// crossover tree is flattened out so that each band is
+//
+//   band 0   LP1 . AP2 . AP3
+//   band 1   HP1 . LP2 . AP3
+//   band 2   HP1 . HP2 . LP3
+//   band 3   HP1 . HP2 . HP3
+//
+// where LPn / HPn are 4th order LR filters at crossover n (two Butterworth
+// biquads each) and APn is the matching allpass, which keeps the bands in
+// phase so they sum flat. Sections a band count doesn't need are set to
+// pass straight through, and unused bands get no drive, so they add nothing.
+struct MultibandClipState
+{
+    static constexpr int maxBands = maxClipBands;
+    static constexpr int numLanes = maxBands;
+    static constexpr int numSections = 2 * (maxBands - 1);
+
+    // Section major, lane minor, so one section across all the bands is one
+    // contiguous row of numLanes floats.
+    using Row = float[numLanes];
+
+    alignas(16) Row b0[numSections];
+    alignas(16) Row b1[numSections];
+    alignas(16) Row b2[numSections];
+    alignas(16) Row a1[numSections];
+    alignas(16) Row a2[numSections];
+
+    alignas(16) Row z1[numSections];
+    alignas(16) Row z2[numSections];
+
+    alignas(16) Row preGain;
+
+    int numBands = 1;
+
+    MultibandClipState();
+
+    // Crossover points for a given band count. Changing them starts the
+    // filters from silence.
+    void setBands(const int newNumBands, const double sampleRate);
+
+    // Linear pre-gain for each band
+    void setBandGain(const int band, const float gain) noexcept;
+
+    void reset() noexcept;
+
+    // Samples for the crossover tails to die away below threshold
+    int getTailSamples(const float threshold) const;
+
+    // Crossover frequencies in Hz for a band count, numBands - 1 of them
+    static std::array<float, maxBands - 1> getCrossoverFrequencies(const int numBands);
+};
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    ShitParameters.cpp
+    Created: 19 Oct 2026 7:12:48pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "ShitParameters.h"
+
+namespace ShitParameters
+{
+// =============================================================================
+// Create plugin params
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        "Bypass",
+        "Bypass",
+        false
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "Drive",
+        "Drive",
+        juce::NormalisableRange<float>(
+            0.f, 10.f, 0.1f, 1.f),
+        5.f
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "Tone",
+        "Tone",
+        juce::NormalisableRange<float>(
+            0.f, 10.f, 0.1f, 1.f),
+        5.f
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "Level",
+        "Level",
+        juce::NormalisableRange<float>(
+            0.f, 10.f, 0.1f, 1.f),
+        5.f
+    ));
+
+    // Anything added since goes on the end, so hosts that address parameters
+    // by index keep their automation and saved sessions
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        "Cab",
+        "Cab",
+        false
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "Quality",
+        "Quality",
+        juce::StringArray { "Eco", "Normal", "High" },
+        1
+    ));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "Bands",
+        "Bands",
+        juce::StringArray { "1", "2", "3", "4" },
+        0
+    ));
+
+    // Drive offset per band, only used when split into bands
+    for (int band = 1; band <= maxClipBands; ++band)
+    {
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            "Band" + juce::String(band) + "Trim",
+            "Band " + juce::String(band) + " Trim",
+            juce::NormalisableRange<float>(
+                -12.f, 12.f, 0.1f, 1.f),
+            0.f
+        ));
+    }
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "Stages",
+        "Stages",
+        juce::StringArray { "1", "2", "3" },
+        0
+    ));
+
+    // Knobs of the stacked stages, stage 1 is Drive, Tone and Level
+    for (int stage = 2; stage <= maxStages; ++stage)
+    {
+        for (auto knob : { "Drive", "Tone", "Level" })
+        {
+            layout.add(std::make_unique<juce::AudioParameterFloat>(
+                "Stage" + juce::String(stage) + knob,
+                "Stage " + juce::String(stage) + " " + knob,
+                juce::NormalisableRange<float>(
+                    0.f, 10.f, 0.1f, 1.f),
+                5.f
+            ));
+        }
+    }
+
+    return layout;
+}
+
+// =============================================================================
+ParameterValues::ParameterValues(juce::AudioProcessorValueTreeState& apvts)
+    : bypass(apvts.getRawParameterValue("Bypass")),
+      cab(apvts.getRawParameterValue("Cab")),
+      quality(apvts.getRawParameterValue("Quality")),
+      drive(apvts.getRawParameterValue("Drive")),
+      tone(apvts.getRawParameterValue("Tone")),
+      level(apvts.getRawParameterValue("Level")),
+      bands(apvts.getRawParameterValue("Bands")),
+      stages(apvts.getRawParameterValue("Stages"))
+{
+    for (int band = 0; band < maxClipBands; ++band)
+        bandTrims[(size_t) band] = apvts.getRawParameterValue("Band" + juce::String(band + 1) + "Trim");
+
+    for (int stage = 2; stage <= maxStages; ++stage)
+    {
+        auto prefix = "Stage" + juce::String(stage);
+
+        stackedStages[(size_t) stage - 2] = { apvts.getRawParameterValue(prefix + "Drive"),
+                                              apvts.getRawParameterValue(prefix + "Tone"),
+                                              apvts.getRawParameterValue(prefix + "Level") };
+    }
+}
+
+// Gett settings frrom plugin.
+ChainSettings getChainSettings(const ParameterValues& values)
+{
+    ChainSettings settings;
+
+    settings.isBypassed = values.bypass->load();
+    settings.cabEnabled = values.cab->load();
+    settings.quality = static_cast<QualityTier>((int) values.quality->load());
+    settings.drive = values.drive->load();
+    settings.tone = values.tone->load();
+    settings.level = values.level->load();
+    settings.numBands = (int) values.bands->load() + 1;
+
+    for (int band = 0; band < maxClipBands; ++band)
+        settings.bandTrims[(size_t) band] = values.bandTrims[(size_t) band]->load();
+
+    settings.numStages = (int) values.stages->load() + 1;
+
+    for (int stage = 0; stage < maxStages - 1; ++stage)
+    {
+        auto& stageValues = values.stackedStages[(size_t) stage];
+        auto& stageSettings = settings.stackedStages[(size_t) stage];
+
+        stageSettings.drive = stageValues.drive->load();
+        stageSettings.tone = stageValues.tone->load();
+        stageSettings.level = stageValues.level->load();
+    }
+
+    return settings;
+}
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    ShitParameters.h
+    Created: 19 Oct 2026 7:12:48pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+
+// The plugin's parameters, and how they turn into engine settings. Kept out
+// of ShitClipper so the engine itself never needs the APVTS.
+namespace ShitParameters
+{
+    // Parameter setup to be used when creating APVTS in plugin.
+    juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+    // The parameters' values, looked up by ID once so the audio thread only
+    // has to load them.
+    struct ParameterValues
+    {
+        explicit ParameterValues(juce::AudioProcessorValueTreeState& apvts);
+
+        std::atomic<float>* bypass;
+        std::atomic<float>* cab;
+        std::atomic<float>* quality;
+        std::atomic<float>* drive;
+        std::atomic<float>* tone;
+        std::atomic<float>* level;
+        std::atomic<float>* bands;
+        std::array<std::atomic<float>*, maxClipBands> bandTrims;
+        std::atomic<float>* stages;
+
+        // Drive, Tone and Level of Stage2 onwards
+        struct StageValues
+        {
+            std::atomic<float>* drive;
+            std::atomic<float>* tone;
+            std::atomic<float>* level;
+        };
+
+        std::array<StageValues, maxStages - 1> stackedStages;
+    };
+
+    // Get settings from APVTS
+    ChainSettings getChainSettings(const ParameterValues& values);
+}
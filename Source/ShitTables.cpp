@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    ShitTables.cpp
+    Created: 19 Oct 2026 4:47:05pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "ShitTables.h"
+
+// =============================================================================
+ShitTables::ShitTables(const double processingRate) : sampleRate(processingRate)
+{
+    clipHpf = design(720.f, sampleRate, true);
+    mainLpf = design(723.4f, sampleRate, false);
+
+    for (int step = 0; step < numParamSteps; ++step)
+    {
+        auto value = (float) step / stepsPerUnit;
+
+        clipLpf[(size_t) step] = design(getClipLpfFreq(value), sampleRate, false);
+
+        // designed as a lowpass, same as the chain always has been
+        toneHpf[(size_t) step] = design(getToneHpfFreq(value), sampleRate, false);
+        toneLpf[(size_t) step] = design(getToneLpfFreq(value), sampleRate, false);
+    }
+}
+
+// =============================================================================
+float ShitTables::getPreGainDecibels(const float drive)
+{
+    return juce::jmap<float>(drive, 0.f, 10.f, 21.f, 41.f);
+}
+
+float ShitTables::getLevelGainDecibels(const float level)
+{
+    return juce::jmap<float>(level, 0.f, 10.f, -20.f, 20.f);
+}
+
+float ShitTables::getClipLpfFreq(const float drive)
+{
+    return juce::jmap<float>(10.f - drive, 0.0, 10.f, 5600.f, 20000.f);
+}
+
+float ShitTables::getToneHpfFreq(const float tone)
+{
+    return juce::jmap<float>(tone, 0.f, 10.f, 20.f, 2066.f);
+}
+
+float ShitTables::getToneLpfFreq(const float tone)
+{
+    return juce::jmap<float>(tone, 0.f, 10.f, 723.4f, 3200.f);
+}
+
+// =============================================================================
+FirstOrderCoefficients ShitTables::getClipLpf(const float drive) const
+{
+    return lookUp(clipLpf, drive, getClipLpfFreq, false);
+}
+
+FirstOrderCoefficients ShitTables::getToneHpf(const float tone) const
+{
+    return lookUp(toneHpf, tone, getToneHpfFreq, false);
+}
+
+FirstOrderCoefficients ShitTables::getToneLpf(const float tone) const
+{
+    return lookUp(toneLpf, tone, getToneLpfFreq, false);
+}
+
+FirstOrderCoefficients ShitTables::lookUp(const Table& table,
+                                            const float value,
+                                            float (*getFreq)(const float),
+                                            bool isHighpass) const
+{
+    auto scaled = value * stepsPerUnit;
+    auto step = juce::roundToInt(scaled);
+
+    if (step >= 0 && step < numParamSteps && std::abs(scaled - (float) step) < 1.0e-3f)
+        return table[(size_t) step];
+
+    return design(getFreq(value), sampleRate, isHighpass);
+}
+
+FirstOrderCoefficients ShitTables::design(const float freq, const double rate, bool isHighpass)
+{
+    using FilterDesign = juce::dsp::FilterDesign<float>;
+
+    auto coefficients = isHighpass ? FilterDesign::designIIRHighpassHighOrderButterworthMethod(freq, rate, 1)
+                                   : FilterDesign::designIIRLowpassHighOrderButterworthMethod(freq, rate, 1);
+
+    return FirstOrderCoefficients::fromIIR(*coefficients[0]);
+}
+
+// =============================================================================
+void ShitTableCache::prefetch(const double sampleRate, const QualityTier tier)
+{
+    request(sampleRate * getOversamplingFactor(tier));
+}
+
+ShitTableCache::TablesPtr ShitTableCache::get(const double sampleRate, const QualityTier tier)
+{
+    return request(sampleRate * getOversamplingFactor(tier)).get();
+}
+
+int ShitTableCache::getNumEntries() const
+{
+    const juce::ScopedLock sl(lock);
+    return (int) entries.size();
+}
+
+std::shared_future<ShitTableCache::TablesPtr> ShitTableCache::request(const double processingRate)
+{
+    const juce::ScopedLock sl(lock);
+
+    auto entry = entries.find(processingRate);
+
+    if (entry != entries.end())
+        return entry->second;
+
+    auto tables = std::async(std::launch::async, [processingRate]
+    {
+        return TablesPtr(std::make_shared<const ShitTables>(processingRate));
+    }).share();
+
+    entries.emplace(processingRate, tables);
+    return tables;
+}
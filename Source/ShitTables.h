@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    ShitTables.h
+    Created: 19 Oct 2026 4:47:05pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <future>
+#include <map>
+#include "ChainSettings.h"
+#include "ShitKernels.h"
+
+// Filter coefficients for every Drive and Tone setting at one processing rate.
+// Never changes once built, so all engines running at that rate can share the
+// same copy. Get them from ShitTableCache rather than building your own.
+struct ShitTables
+{
+    // Drive and Tone move in 0.1 steps over 0..10
+    static constexpr int stepsPerUnit = 10;
+    static constexpr int numParamSteps = 10 * stepsPerUnit + 1;
+
+    explicit ShitTables(const double processingRate);
+
+    // Drive to clipper pre-gain in dB
+    static float getPreGainDecibels(const float drive);
+
+    // Level to output gain in dB
+    static float getLevelGainDecibels(const float level);
+
+    // Parameter to cutoff frequency mappings
+    static float getClipLpfFreq(const float drive);
+    static float getToneHpfFreq(const float tone);
+    static float getToneLpfFreq(const float tone);
+
+    // Table lookups. Values off the parameter grid (offline renders can ask
+    // for anything) are designed on the spot instead.
+    FirstOrderCoefficients getClipLpf(const float drive) const;
+    FirstOrderCoefficients getToneHpf(const float tone) const;
+    FirstOrderCoefficients getToneLpf(const float tone) const;
+
+    using Table = std::array<FirstOrderCoefficients, numParamSteps>;
+
+    const double sampleRate;
+
+    FirstOrderCoefficients clipHpf, mainLpf;
+    Table clipLpf, toneHpf, toneLpf;
+
+private:
+    //==============================================================================
+    FirstOrderCoefficients lookUp(const Table& table,
+                                    const float value,
+                                    float (*getFreq)(const float),
+                                    bool isHighpass) const;
+
+    static FirstOrderCoefficients design(const float freq, const double rate, bool isHighpass);
+};
+
+// Process-wide cache of ShitTables, one per processing rate (host rate times
+// the tier's oversampling factor). The first request for a rate builds its
+// tables on a background thread, everyone after that gets the same read-only
+// copy. Hold it through a juce::SharedResourcePointer so it lives exactly as
+// long as some engine is using it.
+class ShitTableCache
+{
+public:
+    using TablesPtr = std::shared_ptr<const ShitTables>;
+
+    // Start building the tables for this rate and tier if nobody has yet,
+    // without waiting for them.
+    void prefetch(const double sampleRate, const QualityTier tier);
+
+    // Tables for this rate and tier, waiting if they're still being built.
+    TablesPtr get(const double sampleRate, const QualityTier tier);
+
+    int getNumEntries() const;
+
+private:
+    //==============================================================================
+    std::shared_future<TablesPtr> request(const double processingRate);
+
+    juce::CriticalSection lock;
+    std::map<double, std::shared_future<TablesPtr>> entries;
+};
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    ShitWorkerPool.cpp
+    Created: 19 Oct 2026 8:54:21pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "ShitWorkerPool.h"
+
+#if JUCE_LINUX
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#endif
+
+ShitWorkerPool::ShitWorkerPool()
+{}
+
+ShitWorkerPool::~ShitWorkerPool()
+{
+    stop();
+}
+
+// =============================================================================
+void ShitWorkerPool::start(const int numWorkers, const int priority)
+{
+    if (numWorkers == workers.size() && priority == workerPriority)
+        return;
+
+    stop();
+
+    workerPriority = priority;
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto* worker = workers.add(new Worker(*this));
+        worker->startThread(priority);
+    }
+}
+
+void ShitWorkerPool::stop()
+{
+    for (auto* worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->wakeUp.post();
+    }
+
+    for (auto* worker : workers)
+        worker->stopThread(1000);
+
+    workers.clear();
+}
+
+// =============================================================================
+void ShitWorkerPool::run(Task task, void* context, const int numTasks) noexcept
+{
+    if (numTasks <= 0)
+        return;
+
+    // Another caller has the workers, don't wait for them
+    if (inUse.exchange(true, std::memory_order_acquire))
+    {
+        for (int i = 0; i < numTasks; ++i)
+            task(context, i);
+
+        return;
+    }
+
+    // Nothing from the last run is still in flight, so the task can be
+    // swapped before the new generation goes out
+    currentTask = task;
+    currentContext = context;
+    ++currentGeneration;
+
+    tasksDone.store(0, std::memory_order_relaxed);
+    work.store(pack(currentGeneration, 0), std::memory_order_release);
+
+    // The count goes out after the generation, so a worker still holding the
+    // last one can't claim against it
+    numTasksInRun.store(numTasks, std::memory_order_release);
+
+    // Only as many workers as there are tasks to share
+    for (int i = 0; i < juce::jmin(workers.size(), numTasks - 1); ++i)
+        workers.getUnchecked(i)->wakeUp.post();
+
+    runTasks(currentGeneration);
+
+    // Only tasks a worker has already claimed are left to wait for
+    while (tasksDone.load(std::memory_order_acquire) < numTasks)
+        std::this_thread::yield();
+
+    numTasksInRun.store(0, std::memory_order_relaxed);
+    inUse.store(false, std::memory_order_release);
+}
+
+void ShitWorkerPool::runTasks(const juce::uint32 generation) noexcept
+{
+    auto current = work.load(std::memory_order_acquire);
+
+    for (;;)
+    {
+        auto taskIndex = (juce::uint32) (current & 0xffffffff);
+
+        if ((juce::uint32) (current >> 32) != generation
+            || (int) taskIndex >= numTasksInRun.load(std::memory_order_acquire))
+            return;
+
+        if (! work.compare_exchange_weak(current,
+                                            pack(generation, taskIndex + 1),
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire))
+            continue;
+
+        currentTask(currentContext, (int) taskIndex);
+        tasksDone.fetch_add(1, std::memory_order_release);
+
+        current = work.load(std::memory_order_acquire);
+    }
+}
+
+// =============================================================================
+#if JUCE_LINUX
+ShitWorkerPool::WakeSignal::WakeSignal()
+{
+    static_assert(sizeof(count) == sizeof(int), "the futex word has to be a plain int");
+}
+
+ShitWorkerPool::WakeSignal::~WakeSignal()
+{}
+
+void ShitWorkerPool::WakeSignal::post() noexcept
+{
+    count.fetch_add(1);
+
+    // Only into the kernel when a worker is actually asleep
+    if (numWaiting.load() > 0)
+        syscall(SYS_futex, reinterpret_cast<int*>(&count), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void ShitWorkerPool::WakeSignal::wait() noexcept
+{
+    for (;;)
+    {
+        auto current = count.load(std::memory_order_acquire);
+
+        while (current > 0)
+            if (count.compare_exchange_weak(current, current - 1, std::memory_order_acquire))
+                return;
+
+        // Sleeps only while the count is still 0, so a post() landing in
+        // between can't be missed
+        numWaiting.fetch_add(1);
+        syscall(SYS_futex, reinterpret_cast<int*>(&count), FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+        numWaiting.fetch_sub(1);
+    }
+}
+#elif JUCE_MAC || JUCE_IOS
+ShitWorkerPool::WakeSignal::WakeSignal()
+    : semaphore(dispatch_semaphore_create(0))
+{}
+
+ShitWorkerPool::WakeSignal::~WakeSignal()
+{
+    dispatch_release(static_cast<dispatch_semaphore_t>(semaphore));
+}
+
+void ShitWorkerPool::WakeSignal::post() noexcept
+{
+    dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(semaphore));
+}
+
+void ShitWorkerPool::WakeSignal::wait() noexcept
+{
+    dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(semaphore), DISPATCH_TIME_FOREVER);
+}
+#else
+ShitWorkerPool::WakeSignal::WakeSignal()
+{}
+
+ShitWorkerPool::WakeSignal::~WakeSignal()
+{}
+
+void ShitWorkerPool::WakeSignal::post() noexcept
+{
+    event.signal();
+}
+
+void ShitWorkerPool::WakeSignal::wait() noexcept
+{
+    event.wait(-1);
+}
+#endif
+
+// =============================================================================
+ShitWorkerPool::Worker::Worker(ShitWorkerPool& ownerPool)
+    : juce::Thread("PoopSmearer worker"),
+      pool(ownerPool)
+{}
+
+void ShitWorkerPool::Worker::run()
+{
+    for (;;)
+    {
+        wakeUp.wait();
+
+        if (threadShouldExit())
+            return;
+
+        pool.runTasks((juce::uint32) (pool.work.load(std::memory_order_acquire) >> 32));
+    }
+}
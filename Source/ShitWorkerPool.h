@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    ShitWorkerPool.h
+    Created: 19 Oct 2026 8:54:21pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// A few high priority threads that help the audio thread get through a block.
+// run() hands out tasks from one atomic counter, so the audio thread never
+// waits on a worker that hasn't started - anything the workers don't get to
+// in time it simply does itself. Idle workers block until run() wakes them,
+// and the wake never takes a lock.
+// Many callers can share one pool: a run() that finds it busy with someone
+// else's tasks does all of its own itself.
+class ShitWorkerPool
+{
+public:
+    // =============================================================================
+    using Task = void (*)(void* context, int taskIndex);
+
+    ShitWorkerPool();
+    ~ShitWorkerPool();
+
+    // Not real-time safe, and not while anyone is in run(). Offline tools
+    // pass a normal priority so a long job doesn't starve the machine.
+    void start(const int numWorkers, const int priority = juce::Thread::realtimeAudioPriority);
+    void stop();
+
+    int getNumWorkers() const { return workers.size(); }
+
+    // Calls task(context, i) for every i in [0, numTasks), on the workers and
+    // the calling thread, and returns once they have all finished. Real-time
+    // safe, and callable from several threads at once.
+    void run(Task task, void* context, const int numTasks) noexcept;
+
+private:
+    //==============================================================================
+    // Counting semaphore the workers sleep on. post() is a futex wake on
+    // Linux and a dispatch semaphore signal on macOS, neither of which takes
+    // a mutex the way juce::WaitableEvent::signal() does, so the audio thread
+    // can call it every block.
+    class WakeSignal
+    {
+    public:
+        WakeSignal();
+        ~WakeSignal();
+
+        void post() noexcept;
+        void wait() noexcept;
+
+    private:
+       #if JUCE_LINUX
+        std::atomic<int> count { 0 };
+        std::atomic<int> numWaiting { 0 };
+       #elif JUCE_MAC || JUCE_IOS
+        void* semaphore = nullptr;
+       #else
+        // No exporter for these yet, so no lock free wake either
+        juce::WaitableEvent event;
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (WakeSignal)
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        explicit Worker(ShitWorkerPool& ownerPool);
+        void run() override;
+
+        WakeSignal wakeUp;
+
+    private:
+        ShitWorkerPool& pool;
+    };
+
+    // Claim and run tasks of the given generation until there are none left
+    void runTasks(const juce::uint32 generation) noexcept;
+
+    // Generation in the top half, next unclaimed task index in the bottom, so
+    // a worker that wakes late can't claim a task from a newer run().
+    static juce::uint64 pack(juce::uint32 generation, juce::uint32 taskIndex)
+    {
+        return ((juce::uint64) generation << 32) | taskIndex;
+    }
+
+    std::atomic<juce::uint64> work { 0 };
+    std::atomic<int> numTasksInRun { 0 };
+    std::atomic<int> tasksDone { 0 };
+
+    // Set while one caller has the workers
+    std::atomic<bool> inUse { false };
+
+    // Only written by run() while no task is in flight, and only read by
+    // whoever has just claimed a task
+    Task currentTask = nullptr;
+    void* currentContext = nullptr;
+    juce::uint32 currentGeneration = 0;
+
+    juce::OwnedArray<Worker> workers;
+    int workerPriority = juce::Thread::realtimeAudioPriority;
+};
@@ -0,0 +1,394 @@
+/*
+  ==============================================================================
+
+    AliasingBench.cpp
+    Created: 19 Oct 2026 9:37:02pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "AliasingBench.h"
+#include "../../../Source/ShitClipper.h"
+
+namespace AliasingBench
+{
+namespace
+{
+    // =============================================================================
+    enum class Shaper
+    {
+        fastTanh,
+        tanh,
+        adaa,
+        multiband
+    };
+
+    const char* getShaperName(Shaper shaper)
+    {
+        switch (shaper)
+        {
+            case Shaper::fastTanh:  return "fast tanh";
+            case Shaper::tanh:      return "tanh";
+            case Shaper::adaa:      return "ADAA tanh";
+            case Shaper::multiband: return "multiband (4)";
+        }
+
+        return "";
+    }
+
+    struct Config
+    {
+        Shaper shaper;
+        int factorLog2;
+    };
+
+    // =============================================================================
+    // The engine's clip stage on its own: oversampler, clipper and the clip
+    // HPF / LPF at the oversampled rate, run in the engine's sub-blocks.
+    class ClipStage
+    {
+    public:
+        ClipStage(const Config& stageConfig, const double sampleRate, const float drive)
+            : config(stageConfig),
+              tables(sampleRate * (1 << stageConfig.factorLog2))
+        {
+            if (config.factorLog2 > 0)
+            {
+                oversampler = std::make_unique<ShitClipper::Oversampler>(1,
+                                                                        (size_t) config.factorLog2,
+                                                                        ShitClipper::Oversampler::filterHalfBandPolyphaseIIR,
+                                                                        true,
+                                                                        true);
+                oversampler->initProcessing((size_t) ShitClipper::subBlockSize);
+            }
+
+            preGain = juce::Decibels::decibelsToGain(ShitTables::getPreGainDecibels(drive));
+            postGain = juce::Decibels::decibelsToGain(-18.f);
+
+            hpf.setCoefficients(tables.clipHpf);
+            lpf.setCoefficients(tables.getClipLpf(drive));
+
+            multiband.setBands(MultibandClipState::maxBands, tables.sampleRate);
+
+            for (int band = 0; band < MultibandClipState::maxBands; ++band)
+                multiband.setBandGain(band, preGain);
+        }
+
+        void process(float* samples, int numSamples)
+        {
+            for (int pos = 0; pos < numSamples; pos += ShitClipper::subBlockSize)
+            {
+                auto subBlockLength = juce::jmin(ShitClipper::subBlockSize, numSamples - pos);
+                float* channels[] = { samples + pos };
+                juce::dsp::AudioBlock<float> block(channels, 1, (size_t) subBlockLength);
+
+                if (oversampler == nullptr)
+                {
+                    processClip(block);
+                }
+                else
+                {
+                    auto oversampledBlock = oversampler->processSamplesUp(block);
+                    processClip(oversampledBlock);
+                    oversampler->processSamplesDown(block);
+                }
+            }
+        }
+
+    private:
+        void processClip(juce::dsp::AudioBlock<float>& block)
+        {
+            auto& kernels = ShitKernels::getKernels();
+            auto* samples = block.getChannelPointer(0);
+            auto numSamples = (int) block.getNumSamples();
+
+            switch (config.shaper)
+            {
+                case Shaper::fastTanh:  kernels.clipFast(samples, numSamples, preGain, postGain); break;
+                case Shaper::tanh:      kernels.clip(samples, numSamples, preGain, postGain); break;
+                case Shaper::adaa:      kernels.clipAdaa(samples, numSamples, preGain, postGain, adaaState); break;
+                case Shaper::multiband: kernels.multibandClip(samples, numSamples, multiband, postGain); break;
+            }
+
+            FirstOrderFilter* filters[] = { &hpf, &lpf };
+            kernels.filterCascade(samples, numSamples, filters, 2);
+        }
+
+        Config config;
+        ShitTables tables;
+        std::unique_ptr<ShitClipper::Oversampler> oversampler;
+
+        float preGain = 1.f, postGain = 1.f, adaaState = 0.f;
+        FirstOrderFilter hpf, lpf;
+        MultibandClipState multiband;
+    };
+
+    // =============================================================================
+    // Spectrum of the steady state output, as power per bin
+    class SpectrumAnalyser
+    {
+    public:
+        explicit SpectrumAnalyser(const int fftOrder)
+            : fft(fftOrder),
+              window((size_t) fft.getSize(), juce::dsp::WindowingFunction<float>::blackmanHarris, false)
+        {}
+
+        int getSize() const { return fft.getSize(); }
+
+        std::vector<double> getPowerSpectrum(const float* samples)
+        {
+            std::vector<float> data((size_t) getSize() * 2, 0.f);
+            std::copy(samples, samples + getSize(), data.begin());
+
+            window.multiplyWithWindowingTable(data.data(), (size_t) getSize());
+            fft.performFrequencyOnlyForwardTransform(data.data());
+
+            std::vector<double> power((size_t) getSize() / 2);
+
+            for (size_t bin = 0; bin < power.size(); ++bin)
+                power[bin] = (double) data[bin] * data[bin];
+
+            return power;
+        }
+
+    private:
+        juce::dsp::FFT fft;
+        juce::dsp::WindowingFunction<float> window;
+    };
+
+    // Blackman-Harris main lobe, in bins either side
+    constexpr int mainLobeBins = 4;
+
+    // Signal to aliasing ratio in dB: power on the expected bins over power
+    // everywhere else. The lowest bins are left out, nothing lives there.
+    double getSignalToAliasing(const std::vector<double>& power, const std::vector<int>& expectedBins)
+    {
+        std::vector<bool> isExpected(power.size(), false);
+
+        for (auto bin : expectedBins)
+            for (int i = bin - mainLobeBins; i <= bin + mainLobeBins; ++i)
+                if (i >= 0 && i < (int) power.size())
+                    isExpected[(size_t) i] = true;
+
+        double signal = 0.0, aliasing = 0.0;
+
+        for (size_t bin = (size_t) mainLobeBins + 1; bin < power.size(); ++bin)
+            (isExpected[bin] ? signal : aliasing) += power[bin];
+
+        return 10.0 * std::log10((signal + 1.0e-30) / (aliasing + 1.0e-30));
+    }
+
+    // Multiples of an odd bin below Nyquist. Every harmonic and every
+    // intermodulation product of tones on these bins lands on one of them,
+    // while anything folded back from above Nyquist can't, as the FFT size
+    // is a power of two.
+    std::vector<int> getHarmonicBins(const int bin, const int numBins)
+    {
+        std::vector<int> bins;
+
+        for (int harmonic = bin; harmonic < numBins; harmonic += bin)
+            bins.push_back(harmonic);
+
+        return bins;
+    }
+
+    // Nearest odd bin, so no harmonic can fold back onto another harmonic
+    int getOddBin(const double freq, const double sampleRate, const int fftSize)
+    {
+        auto bin = juce::roundToInt(freq / sampleRate * fftSize);
+        return bin | 1;
+    }
+
+    // =============================================================================
+    struct Result
+    {
+        Config config;
+        double nanosPerSample = 0.0;
+        double worstSineSnr = 0.0;
+        double meanSineSnr = 0.0;
+        double twoToneSnr = 0.0;
+        bool isParetoOptimal = false;
+
+        // the figure the Pareto front is built on
+        double getQuality() const { return juce::jmin(worstSineSnr, twoToneSnr); }
+    };
+
+    // Renders a signal through a fresh stage and returns the spectrum of the
+    // tail end, after the filters have settled
+    std::vector<double> renderSpectrum(const Config& config,
+                                        const double sampleRate,
+                                        const float drive,
+                                        SpectrumAnalyser& analyser,
+                                        const std::function<float(int)>& signal)
+    {
+        ClipStage stage(config, sampleRate, drive);
+
+        auto settleSamples = analyser.getSize() / 2;
+        std::vector<float> samples((size_t) (settleSamples + analyser.getSize()));
+
+        for (size_t i = 0; i < samples.size(); ++i)
+            samples[i] = signal((int) i);
+
+        stage.process(samples.data(), (int) samples.size());
+
+        return analyser.getPowerSpectrum(samples.data() + settleSamples);
+    }
+
+    double timeStage(const Config& config, const double sampleRate, const float drive)
+    {
+        constexpr int numRuns = 5;
+        const auto numSamples = (int) sampleRate;
+
+        std::vector<float> input((size_t) numSamples);
+        juce::Random random(0x5417);
+
+        for (auto& sample : input)
+            sample = random.nextFloat() * 2.f - 1.f;
+
+        std::vector<float> samples((size_t) numSamples);
+        auto bestSeconds = std::numeric_limits<double>::max();
+
+        ClipStage stage(config, sampleRate, drive);
+
+        for (int run = 0; run < numRuns; ++run)
+        {
+            samples = input;
+
+            auto start = juce::Time::getHighResolutionTicks();
+            stage.process(samples.data(), numSamples);
+            auto ticks = juce::Time::getHighResolutionTicks() - start;
+
+            bestSeconds = juce::jmin(bestSeconds, juce::Time::highResolutionTicksToSeconds(ticks));
+        }
+
+        return bestSeconds / numSamples * 1.0e9;
+    }
+
+    void markParetoFront(std::vector<Result>& results)
+    {
+        // On the front if nothing else is both at least as cheap and at
+        // least as clean, and strictly better at one of them
+        for (auto& result : results)
+        {
+            result.isParetoOptimal = std::none_of(results.begin(), results.end(), [&result] (const Result& other)
+            {
+                return other.nanosPerSample <= result.nanosPerSample
+                    && other.getQuality() >= result.getQuality()
+                    && (other.nanosPerSample < result.nanosPerSample || other.getQuality() > result.getQuality());
+            });
+        }
+    }
+}
+
+// =============================================================================
+int run(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.getValueForOption("--sample-rate").getDoubleValue();
+    auto drive = args.getValueForOption("--drive").getFloatValue();
+    auto fftOrder = args.getValueForOption("--fft-order").getIntValue();
+
+    if (sampleRate <= 0.0)                  sampleRate = 48000.0;
+    if (! args.containsOption("--drive"))   drive = 10.f;
+    if (fftOrder <= 0)                      fftOrder = 14;
+
+    drive = juce::jlimit(0.f, 10.f, drive);
+
+    SpectrumAnalyser analyser(fftOrder);
+    const auto fftSize = analyser.getSize();
+    const auto numBins = fftSize / 2;
+
+    std::cout << "PoopBench aliasing: " << sampleRate << " Hz, drive " << drive
+              << ", " << fftSize << " point FFT, kernels "
+              << ShitKernels::getIsaName(ShitKernels::getKernels().isa) << std::endl;
+
+    // Stepped sine sweep, and two tones at 11 and 19 times a common odd bin
+    // of about 100 Hz, so their products all land on its multiples
+    const double sweepFreqs[] = { 500.0, 1000.0, 2500.0, 5000.0, 8000.0, 12000.0, 16000.0 };
+    const auto baseBin = getOddBin(100.0, sampleRate, fftSize);
+    const auto toneBin1 = 11 * baseBin;
+    const auto toneBin2 = 19 * baseBin;
+
+    std::vector<Result> results;
+
+    for (auto shaper : { Shaper::fastTanh, Shaper::tanh, Shaper::adaa, Shaper::multiband })
+    {
+        for (int factorLog2 = 0; factorLog2 <= 3; ++factorLog2)
+        {
+            Result result;
+            result.config = { shaper, factorLog2 };
+            result.worstSineSnr = std::numeric_limits<double>::max();
+            auto numSines = 0;
+
+            for (auto freq : sweepFreqs)
+            {
+                if (freq >= sampleRate * 0.45)
+                    continue;
+
+                auto bin = getOddBin(freq, sampleRate, fftSize);
+                auto phaseStep = juce::MathConstants<double>::twoPi * bin / fftSize;
+
+                auto power = renderSpectrum(result.config, sampleRate, drive, analyser, [phaseStep] (int i)
+                {
+                    return 0.5f * (float) std::sin(phaseStep * i);
+                });
+
+                auto snr = getSignalToAliasing(power, getHarmonicBins(bin, numBins));
+
+                result.worstSineSnr = juce::jmin(result.worstSineSnr, snr);
+                result.meanSineSnr += snr;
+                ++numSines;
+            }
+
+            result.meanSineSnr /= juce::jmax(1, numSines);
+
+            auto phaseStep1 = juce::MathConstants<double>::twoPi * toneBin1 / fftSize;
+            auto phaseStep2 = juce::MathConstants<double>::twoPi * toneBin2 / fftSize;
+
+            auto power = renderSpectrum(result.config, sampleRate, drive, analyser, [=] (int i)
+            {
+                return 0.25f * (float) (std::sin(phaseStep1 * i) + std::sin(phaseStep2 * i));
+            });
+
+            result.twoToneSnr = getSignalToAliasing(power, getHarmonicBins(baseBin, numBins));
+            result.nanosPerSample = timeStage(result.config, sampleRate, drive);
+
+            results.push_back(result);
+        }
+    }
+
+    markParetoFront(results);
+
+    std::sort(results.begin(), results.end(), [] (const Result& a, const Result& b)
+    {
+        return a.nanosPerSample < b.nanosPerSample;
+    });
+
+    // =============================================================================
+    std::cout << std::endl
+              << juce::String("clipper").paddedRight(' ', 16)
+              << juce::String("os").paddedLeft(' ', 4)
+              << juce::String("ns/sample").paddedLeft(' ', 12)
+              << juce::String("worst sine").paddedLeft(' ', 12)
+              << juce::String("mean sine").paddedLeft(' ', 12)
+              << juce::String("two-tone").paddedLeft(' ', 12)
+              << "  pareto" << std::endl;
+
+    for (auto& result : results)
+    {
+        std::cout << juce::String(getShaperName(result.config.shaper)).paddedRight(' ', 16)
+                  << (juce::String(1 << result.config.factorLog2) + "x").paddedLeft(' ', 4)
+                  << juce::String(result.nanosPerSample, 2).paddedLeft(' ', 12)
+                  << (juce::String(result.worstSineSnr, 1) + " dB").paddedLeft(' ', 12)
+                  << (juce::String(result.meanSineSnr, 1) + " dB").paddedLeft(' ', 12)
+                  << (juce::String(result.twoToneSnr, 1) + " dB").paddedLeft(' ', 12)
+                  << (result.isParetoOptimal ? "  *" : "") << std::endl;
+    }
+
+    std::cout << std::endl
+              << "SNR is power on the harmonic / intermodulation bins over everything else." << std::endl
+              << "Pareto front (*) on ns/sample against the worse of the worst sine and two-tone SNR." << std::endl;
+
+    return 0;
+}
+}
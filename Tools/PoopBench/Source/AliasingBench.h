@@ -0,0 +1,25 @@
+/*
+  ==============================================================================
+
+    AliasingBench.h
+    Created: 19 Oct 2026 9:37:02pm
+    Author:  bob
+
+    Quality against CPU for the clip stage. Runs every clipper and
+    oversampling combination over stepped sines and a two-tone signal, counts
+    whatever lands off the harmonic (or intermodulation) bins as aliasing, times
+    each combination, and prints the lot with the Pareto front marked.
+
+    PoopBench --aliasing [--sample-rate SR] [--drive D] [--fft-order N]
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace AliasingBench
+{
+    int run(const juce::ArgumentList& args);
+}
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 4:02:17pm
+    Author:  bob
+
+    Startup benchmark. Creates a pile of plugin instances the way a big session
+    load would, and reports how long construction, prepareToPlay, opening the
+    editor and teardown take.
+
+    PoopBench [--instances N] [--sample-rate SR] [--block-size N] [--no-editor]
+
+    With --aliasing it measures the clip stage's aliasing against its CPU
+    cost instead, see AliasingBench.h. The hardware counters per engine stage
+    are Tools/PoopCounters, which builds the engine with the profiling hooks
+    in.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "AliasingBench.h"
+
+namespace
+{
+    // =============================================================================
+    struct Stopwatch
+    {
+        juce::int64 start = juce::Time::getHighResolutionTicks();
+
+        double getMillis() const
+        {
+            auto ticks = juce::Time::getHighResolutionTicks() - start;
+            return juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0;
+        }
+    };
+
+    void printTiming(const juce::String& name, double totalMillis, int count)
+    {
+        std::cout << name.paddedRight(' ', 24)
+                  << juce::String(totalMillis, 2).paddedLeft(' ', 10) << " ms total"
+                  << juce::String(totalMillis / juce::jmax(1, count), 4).paddedLeft(' ', 12)
+                  << " ms each" << std::endl;
+    }
+}
+
+// =============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    if (args.containsOption("--aliasing"))
+        return AliasingBench::run(args);
+
+    auto numInstances = juce::jmax(1, args.getValueForOption("--instances").getIntValue());
+    auto sampleRate = args.getValueForOption("--sample-rate").getDoubleValue();
+    auto blockSize = args.getValueForOption("--block-size").getIntValue();
+    auto openEditors = ! args.containsOption("--no-editor");
+
+    if (! args.containsOption("--instances"))   numInstances = 500;
+    if (sampleRate <= 0.0)                      sampleRate = 48000.0;
+    if (blockSize <= 0)                         blockSize = 512;
+
+    std::cout << "PoopBench: " << numInstances << " instances at "
+              << sampleRate << " Hz, " << blockSize << " sample blocks" << std::endl;
+
+    std::vector<std::unique_ptr<PoopSmearerAudioProcessor>> processors;
+    processors.reserve((size_t) numInstances);
+
+    // Construction. The first one pays for the shared resources.
+    double firstConstructMillis = 0.0, constructMillis = 0.0;
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        Stopwatch timer;
+        processors.push_back(std::make_unique<PoopSmearerAudioProcessor>());
+        (i == 0 ? firstConstructMillis : constructMillis) += timer.getMillis();
+    }
+
+    // prepareToPlay
+    double prepareMillis = 0.0;
+
+    for (auto& processor : processors)
+    {
+        Stopwatch timer;
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+        prepareMillis += timer.getMillis();
+    }
+
+    // prepareToPlay hands the heavy lifting to a background thread, so keep
+    // feeding blocks of silence until every instance has the full engine.
+    Stopwatch backgroundTimer;
+    juce::AudioBuffer<float> silence(2, blockSize);
+    juce::MidiBuffer midi;
+
+    for (;;)
+    {
+        auto numPending = 0;
+
+        for (auto& processor : processors)
+        {
+            if (processor->isEngineFullyPrepared())
+                continue;
+
+            silence.clear();
+            processor->processBlock(silence, midi);
+            numPending += processor->isEngineFullyPrepared() ? 0 : 1;
+        }
+
+        if (numPending == 0)
+            break;
+
+        juce::Thread::sleep(1);
+    }
+
+    auto backgroundPrepareMillis = backgroundTimer.getMillis();
+
+    auto footprint = processors.front()->getEngineMemoryFootprint();
+
+    // Editors. Opened and closed one at a time like a user clicking through
+    // the session, the first one decodes the artwork.
+    double firstEditorMillis = 0.0, editorMillis = 0.0;
+
+    if (openEditors)
+    {
+        for (int i = 0; i < numInstances; ++i)
+        {
+            auto& processor = *processors[(size_t) i];
+
+            Stopwatch timer;
+            std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditorIfNeeded());
+            (i == 0 ? firstEditorMillis : editorMillis) += timer.getMillis();
+        }
+    }
+
+    // Teardown
+    Stopwatch teardownTimer;
+
+    for (auto& processor : processors)
+        processor->releaseResources();
+
+    processors.clear();
+    auto teardownMillis = teardownTimer.getMillis();
+
+    // =============================================================================
+    std::cout << std::endl;
+    printTiming("construct (first)", firstConstructMillis, 1);
+    printTiming("construct (rest)", constructMillis, numInstances - 1);
+    printTiming("prepareToPlay", prepareMillis, numInstances);
+    printTiming("background prepare", backgroundPrepareMillis, numInstances);
+
+    if (openEditors)
+    {
+        printTiming("open editor (first)", firstEditorMillis, 1);
+        printTiming("open editor (rest)", editorMillis, numInstances - 1);
+    }
+
+    printTiming("teardown", teardownMillis, numInstances);
+
+    std::cout << std::endl
+              << "engine memory per instance: " << footprint.getTotalBytes() << " bytes" << std::endl
+              << "  object       " << footprint.objectBytes << std::endl
+              << "  state arena  " << footprint.arenaBytes << std::endl
+              << "  oversamplers " << footprint.oversamplerBytes << " (estimate)" << std::endl
+              << "  cabinet      " << footprint.cabinetBytes << " (estimate)" << std::endl;
+
+    return 0;
+}
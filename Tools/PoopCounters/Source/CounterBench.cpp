@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    CounterBench.cpp
+    Created: 19 Oct 2026 10:21:44pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "CounterBench.h"
+#include "PerfCounters.h"
+#include "../../../Source/ShitClipper.h"
+
+#if ! POOPSMEARER_STAGE_PROFILING
+ #error "PoopCounters needs the engine built with POOPSMEARER_STAGE_PROFILING=1"
+#endif
+
+namespace CounterBench
+{
+namespace
+{
+    // =============================================================================
+    using ProfileStage = ShitClipper::ProfileStage;
+    constexpr auto numProfileStages = (size_t) ProfileStage::numProfileStages;
+
+    // Adds up the counters over every sub-block's run of each stage
+    struct StageRecorder : ShitClipper::ProfileListener
+    {
+        explicit StageRecorder(const PerfCounters& perfCounters) : counters(perfCounters) {}
+
+        void stageStarted(ProfileStage stage) override
+        {
+            startCounts[(size_t) stage] = counters.read();
+        }
+
+        void stageFinished(ProfileStage stage) override
+        {
+            totals[(size_t) stage] += counters.read() - startCounts[(size_t) stage];
+        }
+
+        const PerfCounters& counters;
+        std::array<PerfCounters::Counts, numProfileStages> startCounts;
+        std::array<PerfCounters::Counts, numProfileStages> totals;
+    };
+
+    // A rough call, from how often the stage waits on memory
+    const char* getBoundBy(const PerfCounters::Counts& counts)
+    {
+        constexpr double memoryBoundCacheMpki = 5.0;
+        constexpr double memoryBoundIpc = 1.0;
+
+        if (counts.instructions == 0)
+            return "";
+
+        return counts.getCacheMpki() > memoryBoundCacheMpki || counts.getInstructionsPerCycle() < memoryBoundIpc
+                ? "memory"
+                : "compute";
+    }
+
+    void printHeader()
+    {
+        std::cout << juce::String().paddedRight(' ', 18)
+                  << juce::String("cyc/sample").paddedLeft(' ', 12)
+                  << juce::String("ins/sample").paddedLeft(' ', 12)
+                  << juce::String("cyc/block").paddedLeft(' ', 12)
+                  << juce::String("ins/block").paddedLeft(' ', 12)
+                  << juce::String("IPC").paddedLeft(' ', 7)
+                  << juce::String("cache MPKI").paddedLeft(' ', 12)
+                  << juce::String("branch MPKI").paddedLeft(' ', 13)
+                  << "  bound by" << std::endl;
+    }
+
+    void printRow(const juce::String& name, const PerfCounters::Counts& rawCounts,
+                    juce::int64 numSamples, juce::int64 numBlocks)
+    {
+        auto counts = rawCounts.getScaled();
+
+        auto perSample = [numSamples] (juce::uint64 value) { return (double) value / (double) numSamples; };
+        auto perBlock = [numBlocks] (juce::uint64 value) { return (double) value / (double) numBlocks; };
+
+        std::cout << name.paddedRight(' ', 18)
+                  << juce::String(perSample(counts.cycles), 2).paddedLeft(' ', 12)
+                  << juce::String(perSample(counts.instructions), 2).paddedLeft(' ', 12)
+                  << juce::String(perBlock(counts.cycles), 0).paddedLeft(' ', 12)
+                  << juce::String(perBlock(counts.instructions), 0).paddedLeft(' ', 12)
+                  << juce::String(counts.getInstructionsPerCycle(), 2).paddedLeft(' ', 7)
+                  << juce::String(counts.getCacheMpki(), 3).paddedLeft(' ', 12)
+                  << juce::String(counts.getBranchMpki(), 3).paddedLeft(' ', 13)
+                  << "  " << getBoundBy(counts) << std::endl;
+    }
+
+    QualityTier parseQuality(const juce::String& name)
+    {
+        if (name == "eco")  return QualityTier::eco;
+        if (name == "high") return QualityTier::high;
+
+        return QualityTier::normal;
+    }
+}
+
+// =============================================================================
+int run(const juce::ArgumentList& args)
+{
+    auto sampleRate = args.getValueForOption("--sample-rate").getDoubleValue();
+    auto blockSize = args.getValueForOption("--block-size").getIntValue();
+    auto seconds = args.getValueForOption("--seconds").getDoubleValue();
+
+    if (sampleRate <= 0.0)  sampleRate = 48000.0;
+    if (blockSize <= 0)     blockSize = 512;
+    if (seconds <= 0.0)     seconds = 10.0;
+
+    ChainSettings chainSettings;
+    chainSettings.quality = parseQuality(args.getValueForOption("--quality"));
+    chainSettings.drive = 5.f;
+    chainSettings.tone = 5.f;
+    chainSettings.level = 5.f;
+    chainSettings.numBands = juce::jlimit(1, maxClipBands, juce::jmax(1, args.getValueForOption("--bands").getIntValue()));
+    chainSettings.numStages = juce::jlimit(1, maxStages, juce::jmax(1, args.getValueForOption("--stages").getIntValue()));
+
+    for (auto& stage : chainSettings.stackedStages)
+        stage = { 5.f, 5.f, 5.f };
+
+    PerfCounters counters;
+
+    if (! counters.isAvailable())
+    {
+        std::cerr << "PoopCounters: " << counters.getError() << std::endl;
+        return 1;
+    }
+
+    // Build the whole engine up front, then run it at the tier asked for
+    ShitClipper engine;
+    engine.setNonRealtime(true);
+    engine.prepare({ sampleRate, (juce::uint32) blockSize, 1 }, sampleRate, chainSettings);
+    engine.setNonRealtime(false);
+    engine.setAdaptiveQuality(false);
+
+    // Noise at -12 dBFS, loud enough that the engine never sleeps
+    const auto numBlocks = juce::jmax((juce::int64) 1, (juce::int64) (seconds * sampleRate) / blockSize);
+    const auto numSamples = numBlocks * blockSize;
+
+    juce::AudioBuffer<float> buffer(1, blockSize);
+    juce::Random random(0x5417);
+
+    auto fillBlock = [&]
+    {
+        auto* samples = buffer.getWritePointer(0);
+
+        for (int i = 0; i < blockSize; ++i)
+            samples[i] = 0.25f * (random.nextFloat() * 2.f - 1.f);
+    };
+
+    // warm up the caches and the branch predictors
+    for (int block = 0; block < 100; ++block)
+    {
+        fillBlock();
+        engine.process(buffer, sampleRate, chainSettings);
+    }
+
+    // process() on its own first, so the per-stage reads don't count in it
+    PerfCounters::Counts processTotals;
+
+    for (juce::int64 block = 0; block < numBlocks; ++block)
+    {
+        fillBlock();
+
+        auto start = counters.read();
+        engine.process(buffer, sampleRate, chainSettings);
+        processTotals += counters.read() - start;
+    }
+
+    // then again with every stage measured
+    StageRecorder recorder(counters);
+    engine.setProfileListener(&recorder);
+
+    for (juce::int64 block = 0; block < numBlocks; ++block)
+    {
+        fillBlock();
+        engine.process(buffer, sampleRate, chainSettings);
+    }
+
+    engine.setProfileListener(nullptr);
+
+    // =============================================================================
+    std::cout << "PoopCounters: " << sampleRate << " Hz, " << blockSize << " sample blocks, "
+              << numBlocks << " blocks, quality " << (int) chainSettings.quality
+              << ", " << chainSettings.numBands << " band(s), " << chainSettings.numStages << " stage(s), kernels "
+              << ShitKernels::getIsaName(ShitKernels::getKernels().isa) << std::endl << std::endl;
+
+    printHeader();
+    printRow("process()", processTotals, numSamples, numBlocks);
+
+    std::cout << std::endl;
+
+    for (size_t stage = 0; stage < numProfileStages; ++stage)
+    {
+        auto& totals = recorder.totals[stage];
+
+        if (totals.instructions > 0)
+            printRow(ShitClipper::getProfileStageName(static_cast<ProfileStage>(stage)), totals, numSamples, numBlocks);
+    }
+
+    if (counters.read().isMultiplexed())
+        std::cout << std::endl
+                  << "The kernel multiplexed the counters with other events, so the counts are scaled" << std::endl
+                  << "up from the time they were actually counting and are only estimates." << std::endl;
+
+    std::cout << std::endl
+              << "User space only. Stage rows come from a second run and include a counter read" << std::endl
+              << "per stage per sub-block, the process() row doesn't. \"bound by\" is a rough call:" << std::endl
+              << "memory when IPC < 1 or there are more than 5 cache misses per 1000 instructions." << std::endl;
+
+    return 0;
+}
+}
@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+    CounterBench.h
+    Created: 19 Oct 2026 10:21:44pm
+    Author:  bob
+
+    Hardware counters for the DSP path. Runs one engine over noise and
+    reports cycles, instructions, cache misses and branch misses for
+    ShitClipper::process() as a whole, then for each chain stage, per sample
+    and per block. Linux only.
+
+    PoopCounters [--sample-rate SR] [--block-size N] [--seconds S]
+                 [--quality eco|normal|high] [--bands N] [--stages N]
+
+    The stage hooks need the engine built with POOPSMEARER_STAGE_PROFILING,
+    so this is a tool of its own rather than a PoopBench mode - PoopBench
+    times the engine exactly as the plugin ships it.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace CounterBench
+{
+    int run(const juce::ArgumentList& args);
+}
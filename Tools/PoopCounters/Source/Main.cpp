@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 11:37:05am
+    Author:  bob
+
+    Hardware counter profile of the engine, see CounterBench.h.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CounterBench.h"
+
+// =============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    return CounterBench::run(args);
+}
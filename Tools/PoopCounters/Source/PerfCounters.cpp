@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    PerfCounters.cpp
+    Created: 19 Oct 2026 10:21:44pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "PerfCounters.h"
+
+#if JUCE_LINUX
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+ #include <cerrno>
+ #include <cstring>
+#endif
+
+// =============================================================================
+PerfCounters::Counts& PerfCounters::Counts::operator+=(const Counts& other)
+{
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cacheMisses += other.cacheMisses;
+    branchMisses += other.branchMisses;
+    timeEnabled += other.timeEnabled;
+    timeRunning += other.timeRunning;
+    return *this;
+}
+
+PerfCounters::Counts PerfCounters::Counts::operator-(const Counts& other) const
+{
+    return { cycles - other.cycles,
+             instructions - other.instructions,
+             cacheMisses - other.cacheMisses,
+             branchMisses - other.branchMisses,
+             timeEnabled - other.timeEnabled,
+             timeRunning - other.timeRunning };
+}
+
+PerfCounters::Counts PerfCounters::Counts::getScaled() const
+{
+    if (timeRunning == 0 || ! isMultiplexed())
+        return *this;
+
+    auto scale = [this] (juce::uint64 value)
+    {
+        return (juce::uint64) ((double) value * (double) timeEnabled / (double) timeRunning);
+    };
+
+    return { scale(cycles), scale(instructions), scale(cacheMisses), scale(branchMisses),
+             timeEnabled, timeEnabled };
+}
+
+double PerfCounters::Counts::getInstructionsPerCycle() const
+{
+    return cycles > 0 ? (double) instructions / (double) cycles : 0.0;
+}
+
+double PerfCounters::Counts::getCacheMpki() const
+{
+    return instructions > 0 ? 1000.0 * (double) cacheMisses / (double) instructions : 0.0;
+}
+
+double PerfCounters::Counts::getBranchMpki() const
+{
+    return instructions > 0 ? 1000.0 * (double) branchMisses / (double) instructions : 0.0;
+}
+
+// =============================================================================
+#if JUCE_LINUX
+
+PerfCounters::PerfCounters()
+{
+    const std::pair<juce::uint32, juce::uint64> events[] =
+    {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+    };
+
+    for (size_t i = 0; i < fds.size(); ++i)
+    {
+        fds[i] = openCounter(events[i].first, events[i].second, i == 0 ? -1 : fds[0]);
+
+        if (fds[i] < 0)
+        {
+            error = juce::String("perf_event_open failed: ") + std::strerror(errno)
+                    + " (see /proc/sys/kernel/perf_event_paranoid)";
+
+            for (auto& fd : fds)
+            {
+                if (fd >= 0)
+                    close(fd);
+
+                fd = -1;
+            }
+
+            return;
+        }
+    }
+
+    groupFd = fds[0];
+
+    ioctl(groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (auto fd : fds)
+        if (fd >= 0)
+            close(fd);
+}
+
+int PerfCounters::openCounter(juce::uint32 type, juce::uint64 config, int group)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group < 0 ? 1 : 0;      // the leader starts the group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // this thread, any CPU
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+PerfCounters::Counts PerfCounters::read() const
+{
+    // The number of counters, the times enabled and running, then the values
+    // in the order they were opened
+    juce::uint64 values[3 + 4] = {};
+
+    if (groupFd < 0 || ::read(groupFd, values, sizeof(values)) != (ssize_t) sizeof(values))
+        return {};
+
+    return { values[3], values[4], values[5], values[6], values[1], values[2] };
+}
+
+#else
+
+PerfCounters::PerfCounters()
+{
+    error = "hardware counters are only supported on Linux";
+}
+
+PerfCounters::~PerfCounters()
+{}
+
+int PerfCounters::openCounter(juce::uint32, juce::uint64, int)
+{
+    return -1;
+}
+
+PerfCounters::Counts PerfCounters::read() const
+{
+    return {};
+}
+
+#endif
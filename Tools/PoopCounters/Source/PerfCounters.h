@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    PerfCounters.h
+    Created: 19 Oct 2026 10:21:44pm
+    Author:  bob
+
+    Hardware performance counters for the calling thread, through Linux
+    perf_event_open. Cycles, instructions, cache misses and branch misses are
+    opened as one group so they always cover exactly the same stretch of code.
+    User space only, so the reads themselves barely show up. Everywhere else,
+    or when the kernel won't allow it, isAvailable() is false.
+
+    When there are more events about than hardware counters the kernel takes
+    turns between groups, and the raw counts come up short. Counts keep how
+    long the group was enabled and how long it was actually counting, so
+    getScaled() can scale them back up - only an estimate, which is what
+    isMultiplexed() warns about.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class PerfCounters
+{
+public:
+    // =============================================================================
+    struct Counts
+    {
+        juce::uint64 cycles = 0;
+        juce::uint64 instructions = 0;
+        juce::uint64 cacheMisses = 0;
+        juce::uint64 branchMisses = 0;
+
+        // nanoseconds the group was enabled, and actually counting
+        juce::uint64 timeEnabled = 0;
+        juce::uint64 timeRunning = 0;
+
+        Counts& operator+=(const Counts& other);
+        Counts operator-(const Counts& other) const;
+
+        bool isMultiplexed() const { return timeRunning < timeEnabled; }
+
+        // Scaled up to the whole time enabled, when multiplexed
+        Counts getScaled() const;
+
+        double getInstructionsPerCycle() const;
+
+        // misses per thousand instructions
+        double getCacheMpki() const;
+        double getBranchMpki() const;
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    bool isAvailable() const { return groupFd >= 0; }
+
+    // Why they couldn't be opened, when they couldn't
+    juce::String getError() const { return error; }
+
+    // Raw running totals since construction. Cheap enough to call around
+    // every stage of every sub-block.
+    Counts read() const;
+
+private:
+    //==============================================================================
+    int openCounter(juce::uint32 type, juce::uint64 config, int group);
+
+    int groupFd = -1;
+    std::array<int, 4> fds { -1, -1, -1, -1 };
+    juce::String error;
+
+    JUCE_DECLARE_NON_COPYABLE(PerfCounters)
+};
@@ -0,0 +1,44 @@
+#!/bin/sh
+#
+# Records the golden renders in Tools/PoopGate/Golden, so the gate has
+# something to check against. Builds PoopGate from the engine at the given
+# git ref (HEAD if there isn't one) in a scratch worktree and runs it with
+# --record, so the goldens always come from a known commit rather than
+# whatever is half done in the working copy. Commit the three WAVs it
+# writes along with the change that called for them.
+#
+#   Tools/PoopGate/RecordGolden.sh [ref]
+#
+# Needs Projucer on the PATH, and JUCE two folders up from the repo where
+# the .jucer module paths expect it.
+
+set -e
+
+ref="${1:-HEAD}"
+gateDir="$(cd "$(dirname "$0")" && pwd)"
+repoDir="$(git -C "$gateDir" rev-parse --show-toplevel)"
+scratchDir="$(mktemp -d)"
+worktree="$scratchDir/Projects/PoopSmearer"
+
+cleanup()
+{
+    git -C "$repoDir" worktree remove --force "$worktree" 2>/dev/null || true
+    rm -rf "$scratchDir"
+}
+
+trap cleanup EXIT
+
+git -C "$repoDir" worktree add --detach "$worktree" "$ref"
+
+# The worktree sits somewhere else, so point the module paths back at the
+# JUCE this checkout uses
+ln -s "$(dirname "$(dirname "$repoDir")")/JUCE" "$scratchDir/JUCE"
+
+cd "$worktree/Tools/PoopGate"
+Projucer --resave PoopGate.jucer
+make -C Builds/LinuxMakefile CONFIG=Release -j"$(nproc 2>/dev/null || echo 4)"
+
+mkdir -p "$gateDir/Golden"
+Builds/LinuxMakefile/build/PoopGate --record --golden "$gateDir/Golden"
+
+echo "recorded from $(git -C "$worktree" rev-parse --short HEAD)"
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    CpuBudget.cpp
+    Created: 20 Oct 2026 9:14:52am
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "CpuBudget.h"
+#include "GoldenRenders.h"
+#include "../../../Source/ShitClipper.h"
+
+namespace CpuBudget
+{
+namespace
+{
+    // =============================================================================
+    constexpr int numRuns = 3;
+
+    double getBlockMicros()
+    {
+        return 1.0e6 * GoldenRenders::blockSize / GoldenRenders::sampleRate;
+    }
+
+    void processBlock(ShitClipper& engine, float* samples, int numSamples, const ChainSettings& settings)
+    {
+        float* channels[] = { samples };
+        juce::AudioBuffer<float> buffer(channels, 1, numSamples);
+
+        engine.process(buffer, GoldenRenders::sampleRate, settings);
+    }
+
+    // Runs silence through until the full engine is in and faded over to, so
+    // the fallback path doesn't get timed
+    bool waitForFullEngine(ShitClipper& engine, const ChainSettings& settings)
+    {
+        std::vector<float> silence((size_t) GoldenRenders::blockSize, 0.f);
+
+        for (int attempt = 0; attempt < 10000 && ! engine.isFullyPrepared(); ++attempt)
+        {
+            processBlock(engine, silence.data(), GoldenRenders::blockSize, settings);
+            juce::Thread::sleep(1);
+        }
+
+        for (int block = 0; block < 4; ++block)
+            processBlock(engine, silence.data(), GoldenRenders::blockSize, settings);
+
+        return engine.isFullyPrepared();
+    }
+}
+
+// =============================================================================
+double getBudgetMicros(QualityTier tier, const double scale)
+{
+    static constexpr double budgetShares[] = { 0.005, 0.01, 0.02 };
+
+    return budgetShares[(size_t) tier] * getBlockMicros() * scale;
+}
+
+Result measure(const std::vector<float>& input, const ChainSettings& settings, const double budgetScale)
+{
+    Result result;
+    result.budgetMicros = getBudgetMicros(settings.quality, budgetScale);
+    result.meanBlockMicros = std::numeric_limits<double>::max();
+
+    ShitClipper engine;
+    engine.setAdaptiveQuality(false);
+    engine.prepare({ GoldenRenders::sampleRate, (juce::uint32) GoldenRenders::blockSize, 1 },
+                    GoldenRenders::sampleRate,
+                    settings);
+
+    if (! waitForFullEngine(engine, settings))
+    {
+        // never prepared, so nothing to time - count it as over budget
+        result.meanBlockMicros = result.worstBlockMicros = std::numeric_limits<double>::infinity();
+        return result;
+    }
+
+    std::vector<float> samples;
+
+    for (int run = 0; run < numRuns; ++run)
+    {
+        samples = input;
+
+        double totalMicros = 0.0;
+        int numBlocks = 0;
+
+        for (size_t pos = 0; pos < samples.size(); pos += (size_t) GoldenRenders::blockSize)
+        {
+            auto numSamples = (int) juce::jmin((size_t) GoldenRenders::blockSize, samples.size() - pos);
+
+            auto start = juce::Time::getHighResolutionTicks();
+            processBlock(engine, samples.data() + pos, numSamples, settings);
+            auto ticks = juce::Time::getHighResolutionTicks() - start;
+
+            auto micros = juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+
+            totalMicros += micros;
+            result.worstBlockMicros = juce::jmax(result.worstBlockMicros, micros);
+            ++numBlocks;
+        }
+
+        result.meanBlockMicros = juce::jmin(result.meanBlockMicros, totalMicros / juce::jmax(1, numBlocks));
+    }
+
+    return result;
+}
+}
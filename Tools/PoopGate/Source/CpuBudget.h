@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    CpuBudget.h
+    Created: 20 Oct 2026 9:14:52am
+    Author:  bob
+
+    Per block CPU time of the engine, running in real time at each quality
+    tier, against a budget per tier. The budgets are a share of the time a
+    512 sample block lasts at 48 kHz (10.7 ms):
+
+        eco     0.5 %       53 us
+        normal  1 %        107 us
+        high    2 %        213 us
+
+    They're set well above what the engine needs on a current desktop core,
+    so they catch a real regression rather than a noisy machine. --budget-scale
+    scales all of them for slower build machines.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/ChainSettings.h"
+
+namespace CpuBudget
+{
+    double getBudgetMicros(QualityTier tier, const double scale);
+
+    struct Result
+    {
+        double meanBlockMicros = 0.0;       // the best of a few runs' means
+        double worstBlockMicros = 0.0;
+        double budgetMicros = 0.0;
+
+        bool isWithinBudget() const { return meanBlockMicros <= budgetMicros; }
+    };
+
+    // Times input through a real-time engine at settings.quality, once the
+    // background prepare has landed
+    Result measure(const std::vector<float>& input, const ChainSettings& settings, const double budgetScale);
+}
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    GoldenRenders.cpp
+    Created: 20 Oct 2026 9:14:52am
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "GoldenRenders.h"
+#include "../../../Source/ShitClipper.h"
+
+namespace GoldenRenders
+{
+// =============================================================================
+std::vector<ChainSettings> getMatrix()
+{
+    std::vector<ChainSettings> matrix;
+
+    for (auto drive : { 0.f, 5.f, 10.f })
+        for (auto tone : { 0.f, 5.f, 10.f })
+            for (auto level : { 0.f, 5.f, 10.f })
+            {
+                ChainSettings settings;
+                settings.drive = drive;
+                settings.tone = tone;
+                settings.level = level;
+
+                matrix.push_back(settings);
+            }
+
+    return matrix;
+}
+
+juce::String describe(const ChainSettings& settings)
+{
+    return "drive " + juce::String(settings.drive, 1)
+         + ", tone " + juce::String(settings.tone, 1)
+         + ", level " + juce::String(settings.level, 1);
+}
+
+std::vector<float> render(const std::vector<float>& input, const ChainSettings& settings)
+{
+    ShitClipper engine;
+    engine.setNonRealtime(true);
+    engine.prepare({ sampleRate, (juce::uint32) blockSize, 1 }, sampleRate, settings);
+
+    auto output = input;
+
+    for (size_t pos = 0; pos < output.size(); pos += (size_t) blockSize)
+    {
+        auto numSamples = (int) juce::jmin((size_t) blockSize, output.size() - pos);
+        float* channels[] = { output.data() + pos };
+        juce::AudioBuffer<float> buffer(channels, 1, numSamples);
+
+        engine.process(buffer, sampleRate, settings);
+    }
+
+    return output;
+}
+
+// =============================================================================
+Difference compare(const std::vector<float>& rendered, const std::vector<float>& golden)
+{
+    Difference difference;
+
+    // a render of the wrong length is as far off as it gets
+    if (rendered.size() != golden.size())
+    {
+        difference.peak = difference.rms = std::numeric_limits<float>::infinity();
+        return difference;
+    }
+
+    double sumOfSquares = 0.0;
+
+    for (size_t i = 0; i < rendered.size(); ++i)
+    {
+        auto error = std::abs(rendered[i] - golden[i]);
+
+        difference.peak = juce::jmax(difference.peak, error);
+        sumOfSquares += (double) error * error;
+    }
+
+    difference.rms = (float) std::sqrt(sumOfSquares / (double) juce::jmax((size_t) 1, rendered.size()));
+
+    return difference;
+}
+
+// =============================================================================
+bool write(const juce::File& file, const std::vector<std::vector<float>>& renders, juce::String& errorMessage)
+{
+    jassert(! renders.empty());
+
+    const auto numChannels = (int) renders.size();
+    const auto numSamples = (int) renders.front().size();
+
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        buffer.copyFrom(channel, 0, renders[(size_t) channel].data(), numSamples);
+
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+
+    std::unique_ptr<juce::FileOutputStream> stream(file.createOutputStream());
+
+    if (stream == nullptr || stream->failedToOpen())
+    {
+        errorMessage = "can't create " + file.getFullPathName();
+        return false;
+    }
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(),
+                                                                               sampleRate,
+                                                                               (unsigned int) numChannels,
+                                                                               32,
+                                                                               {},
+                                                                               0));
+
+    if (writer == nullptr)
+    {
+        errorMessage = "can't write a WAV to " + file.getFullPathName();
+        return false;
+    }
+
+    // the writer owns the stream now
+    stream.release();
+
+    if (! writer->writeFromAudioSampleBuffer(buffer, 0, numSamples))
+    {
+        errorMessage = "failed writing " + file.getFullPathName();
+        return false;
+    }
+
+    return true;
+}
+
+bool read(const juce::File& file, std::vector<std::vector<float>>& renders, juce::String& errorMessage)
+{
+    if (! file.existsAsFile())
+    {
+        errorMessage = "no golden file " + file.getFullPathName() + ", record them with RecordGolden.sh";
+        return false;
+    }
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatReader> reader(wavFormat.createReaderFor(file.createInputStream().release(),
+                                                                               true));
+
+    if (reader == nullptr || reader->sampleRate != sampleRate || ! reader->usesFloatingPointData)
+    {
+        errorMessage = file.getFullPathName() + " isn't a 48 kHz float WAV";
+        return false;
+    }
+
+    const auto numChannels = (int) reader->numChannels;
+    const auto numSamples = (int) reader->lengthInSamples;
+
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+    reader->read(&buffer, 0, numSamples, 0, true, true);
+
+    renders.clear();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* samples = buffer.getReadPointer(channel);
+        renders.emplace_back(samples, samples + numSamples);
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    GoldenRenders.h
+    Created: 20 Oct 2026 9:14:52am
+    Author:  bob
+
+    Offline renders of the Drive/Tone/Level matrix, and how they compare with
+    the golden ones. Each test signal's golden file is a 32 bit float WAV at
+    48 kHz with one channel per matrix setting, in getMatrix() order.
+
+    A render passes when no sample is more than peakTolerance (-60 dBFS) off
+    the golden one, and the RMS of the difference is under rmsTolerance
+    (-80 dBFS). The kernel variants for each instruction set are held to a
+    tighter -80 dBFS peak and -100 dBFS RMS against the baseline ones, since
+    they only differ in rounding.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/ChainSettings.h"
+
+namespace GoldenRenders
+{
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+
+    static constexpr float peakTolerance = 1.0e-3f;
+    static constexpr float rmsTolerance = 1.0e-4f;
+
+    static constexpr float isaPeakTolerance = 1.0e-4f;
+    static constexpr float isaRmsTolerance = 1.0e-5f;
+
+    // Drive, Tone and Level each at 0, 5 and 10
+    std::vector<ChainSettings> getMatrix();
+    juce::String describe(const ChainSettings& settings);
+
+    // Offline, so at the highest quality tier with the full engine from the
+    // first sample
+    std::vector<float> render(const std::vector<float>& input, const ChainSettings& settings);
+
+    struct Difference
+    {
+        float peak = 0.f;
+        float rms = 0.f;
+
+        bool isWithinTolerance() const { return isWithin(peakTolerance, rmsTolerance); }
+
+        bool isWithin(float peakLimit, float rmsLimit) const
+        {
+            return peak <= peakLimit && rms <= rmsLimit;
+        }
+    };
+
+    Difference compare(const std::vector<float>& rendered, const std::vector<float>& golden);
+
+    bool write(const juce::File& file, const std::vector<std::vector<float>>& renders, juce::String& errorMessage);
+    bool read(const juce::File& file, std::vector<std::vector<float>>& renders, juce::String& errorMessage);
+}
@@ -0,0 +1,288 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 9:14:52am
+    Author:  bob
+
+    Regression gate. Renders the test signals through the engine at every
+    Drive/Tone/Level setting in the matrix and compares each render with the
+    golden one, renders them again with each instruction set's kernels to
+    check they match the baseline ones, then times the engine at every
+    setting and quality tier against its CPU budget. Exits with 1 if anything
+    is out of tolerance or over budget, so a build can stop on it.
+
+    PoopGate [--golden DIR] [--record] [--no-isa] [--no-cpu] [--budget-scale X]
+
+    The golden files live in Tools/PoopGate/Golden, which is also the default
+    for --golden when run from Tools/PoopGate. --record renders them afresh
+    from the current engine instead of checking against them, for when a
+    change to the sound is meant. RecordGolden.sh does that from a clean
+    build of a given commit. See GoldenRenders.h for the tolerances and
+    CpuBudget.h for the budgets.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/ShitKernels.h"
+#include "CpuBudget.h"
+#include "GoldenRenders.h"
+#include "TestSignals.h"
+
+namespace
+{
+    // =============================================================================
+    const char* getTierName(QualityTier tier)
+    {
+        switch (tier)
+        {
+            case QualityTier::eco:      return "eco";
+            case QualityTier::normal:   return "normal";
+            case QualityTier::high:     return "high";
+        }
+
+        return "";
+    }
+
+    juce::String toDecibels(float gain)
+    {
+        return juce::String(juce::Decibels::gainToDecibels(gain, -200.f), 1) + " dB";
+    }
+
+    // Renders every signal at every setting, and either records the results
+    // or checks them. Returns the number of failures.
+    int runGoldenRenders(const juce::File& goldenDirectory, const bool record)
+    {
+        auto matrix = GoldenRenders::getMatrix();
+        int numFailures = 0;
+
+        for (auto signal : TestSignals::allSignals)
+        {
+            auto input = TestSignals::generate(signal, GoldenRenders::sampleRate);
+            auto goldenFile = goldenDirectory.getChildFile(juce::String(TestSignals::getName(signal)) + ".wav");
+
+            std::vector<std::vector<float>> renders;
+
+            for (auto& settings : matrix)
+                renders.push_back(GoldenRenders::render(input, settings));
+
+            juce::String errorMessage;
+
+            if (record)
+            {
+                if (! GoldenRenders::write(goldenFile, renders, errorMessage))
+                {
+                    std::cerr << "PoopGate: " << errorMessage << std::endl;
+                    return (int) matrix.size();
+                }
+
+                std::cout << "recorded " << goldenFile.getFullPathName() << std::endl;
+                continue;
+            }
+
+            std::vector<std::vector<float>> golden;
+
+            if (! GoldenRenders::read(goldenFile, golden, errorMessage))
+            {
+                std::cerr << "PoopGate: " << errorMessage << std::endl;
+                numFailures += (int) matrix.size();
+                continue;
+            }
+
+            if (golden.size() != matrix.size())
+            {
+                std::cerr << "PoopGate: " << goldenFile.getFullPathName() << " has " << (int) golden.size()
+                          << " renders, the matrix has " << (int) matrix.size() << std::endl;
+                numFailures += (int) matrix.size();
+                continue;
+            }
+
+            int numSignalFailures = 0;
+
+            for (size_t i = 0; i < matrix.size(); ++i)
+            {
+                auto difference = GoldenRenders::compare(renders[i], golden[i]);
+
+                if (difference.isWithinTolerance())
+                    continue;
+
+                std::cout << "  FAIL " << TestSignals::getName(signal) << ", "
+                          << GoldenRenders::describe(matrix[i])
+                          << ": peak " << toDecibels(difference.peak)
+                          << ", rms " << toDecibels(difference.rms) << std::endl;
+
+                ++numSignalFailures;
+            }
+
+            std::cout << juce::String(TestSignals::getName(signal)).paddedRight(' ', 8)
+                      << (int) matrix.size() - numSignalFailures << " / " << (int) matrix.size()
+                      << " renders within tolerance" << std::endl;
+
+            numFailures += numSignalFailures;
+        }
+
+        return numFailures;
+    }
+
+    // Renders every signal at every setting with each instruction set this CPU
+    // has, the same as picking them with POOPSMEARER_ISA, and checks them
+    // against the baseline kernels. Returns the number of mismatches.
+    int runIsaCheck()
+    {
+        using Isa = ShitKernels::Isa;
+
+        const auto selectedIsa = ShitKernels::getKernels().isa;
+        const auto bestIsa = ShitKernels::getBestSupportedIsa();
+
+        if (bestIsa == Isa::baseline)
+        {
+            std::cout << "only the baseline kernels run on this CPU, no variants to compare" << std::endl;
+            return 0;
+        }
+
+        auto matrix = GoldenRenders::getMatrix();
+        int numFailures = 0;
+
+        for (auto isa : { Isa::avx2, Isa::avx512 })
+        {
+            if (isa > bestIsa)
+                continue;
+
+            int numIsaFailures = 0;
+
+            for (auto signal : TestSignals::allSignals)
+            {
+                auto input = TestSignals::generate(signal, GoldenRenders::sampleRate);
+
+                for (auto& settings : matrix)
+                {
+                    ShitKernels::setIsaOverride(Isa::baseline);
+                    auto baseline = GoldenRenders::render(input, settings);
+
+                    ShitKernels::setIsaOverride(isa);
+                    auto variant = GoldenRenders::render(input, settings);
+
+                    auto difference = GoldenRenders::compare(variant, baseline);
+
+                    if (difference.isWithin(GoldenRenders::isaPeakTolerance, GoldenRenders::isaRmsTolerance))
+                        continue;
+
+                    std::cout << "  FAIL " << ShitKernels::getIsaName(isa) << ", "
+                              << TestSignals::getName(signal) << ", " << GoldenRenders::describe(settings)
+                              << ": peak " << toDecibels(difference.peak)
+                              << ", rms " << toDecibels(difference.rms) << std::endl;
+
+                    ++numIsaFailures;
+                }
+            }
+
+            const auto numRenders = (int) (matrix.size() * std::size(TestSignals::allSignals));
+
+            std::cout << juce::String(ShitKernels::getIsaName(isa)).paddedRight(' ', 8)
+                      << numRenders - numIsaFailures << " / " << numRenders
+                      << " renders match the baseline kernels" << std::endl;
+
+            numFailures += numIsaFailures;
+        }
+
+        ShitKernels::setIsaOverride(selectedIsa);
+
+        return numFailures;
+    }
+
+    // Times every setting at every tier. Returns the number over budget.
+    int runCpuBudget(const double budgetScale)
+    {
+        // Two seconds of noise, so nothing sleeps and every block counts
+        auto noise = TestSignals::generate(TestSignals::Signal::noise, GoldenRenders::sampleRate);
+        std::vector<float> input;
+
+        while (input.size() < (size_t) (2.0 * GoldenRenders::sampleRate))
+            input.insert(input.end(), noise.begin(), noise.end());
+
+        int numFailures = 0;
+
+        for (int tier = 0; tier < numQualityTiers; ++tier)
+        {
+            auto quality = static_cast<QualityTier>(tier);
+            double worstMeanMicros = 0.0;
+            int numTierFailures = 0;
+
+            for (auto settings : GoldenRenders::getMatrix())
+            {
+                settings.quality = quality;
+                auto result = CpuBudget::measure(input, settings, budgetScale);
+
+                worstMeanMicros = juce::jmax(worstMeanMicros, result.meanBlockMicros);
+
+                if (result.isWithinBudget())
+                    continue;
+
+                std::cout << "  OVER " << getTierName(quality) << ", " << GoldenRenders::describe(settings)
+                          << ": " << juce::String(result.meanBlockMicros, 1) << " us a block, budget "
+                          << juce::String(result.budgetMicros, 1) << " us" << std::endl;
+
+                ++numTierFailures;
+            }
+
+            std::cout << juce::String(getTierName(quality)).paddedRight(' ', 8)
+                      << "worst " << juce::String(worstMeanMicros, 1) << " us a block, budget "
+                      << juce::String(CpuBudget::getBudgetMicros(quality, budgetScale), 1) << " us"
+                      << (numTierFailures > 0 ? ", " + juce::String(numTierFailures) + " over" : juce::String())
+                      << std::endl;
+
+            numFailures += numTierFailures;
+        }
+
+        return numFailures;
+    }
+}
+
+// =============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    juce::String goldenPath = args.getValueForOption("--golden");
+    auto record = args.containsOption("--record");
+    auto checkIsa = ! args.containsOption("--no-isa") && ! record;
+    auto checkCpu = ! args.containsOption("--no-cpu") && ! record;
+    auto budgetScale = args.getValueForOption("--budget-scale").getDoubleValue();
+
+    if (goldenPath.isEmpty())   goldenPath = "Golden";
+    if (budgetScale <= 0.0)     budgetScale = 1.0;
+
+    auto goldenDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(goldenPath);
+
+    std::cout << "PoopGate: " << GoldenRenders::sampleRate << " Hz, kernels "
+              << ShitKernels::getIsaName(ShitKernels::getKernels().isa) << std::endl << std::endl;
+
+    auto numRenderFailures = runGoldenRenders(goldenDirectory, record);
+    auto numIsaFailures = 0;
+    auto numCpuFailures = 0;
+
+    if (checkIsa)
+    {
+        std::cout << std::endl;
+        numIsaFailures = runIsaCheck();
+    }
+
+    if (checkCpu)
+    {
+        std::cout << std::endl;
+        numCpuFailures = runCpuBudget(budgetScale);
+    }
+
+    if (record)
+        return numRenderFailures > 0 ? 1 : 0;
+
+    const auto numFailures = numRenderFailures + numIsaFailures + numCpuFailures;
+
+    std::cout << std::endl << (numFailures == 0 ? "PASS" : "FAIL")
+              << ": " << numRenderFailures << " renders out of tolerance, "
+              << numIsaFailures << " kernel mismatches, "
+              << numCpuFailures << " settings over budget" << std::endl;
+
+    return numFailures == 0 ? 0 : 1;
+}
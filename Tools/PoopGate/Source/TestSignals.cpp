@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    TestSignals.cpp
+    Created: 20 Oct 2026 9:14:52am
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "TestSignals.h"
+
+namespace TestSignals
+{
+namespace
+{
+    // =============================================================================
+    std::vector<float> generateSweep(const double sampleRate)
+    {
+        const auto numSamples = (int) (0.5 * sampleRate);
+        const auto startFreq = 20.0;
+        const auto endFreq = juce::jmin(20000.0, 0.45 * sampleRate);
+        const auto seconds = numSamples / sampleRate;
+        const auto logRatio = std::log(endFreq / startFreq);
+
+        std::vector<float> samples((size_t) numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto t = i / sampleRate;
+            auto phase = juce::MathConstants<double>::twoPi * startFreq * seconds / logRatio
+                            * (std::exp(t / seconds * logRatio) - 1.0);
+
+            samples[(size_t) i] = 0.5f * (float) std::sin(phase);
+        }
+
+        return samples;
+    }
+
+    std::vector<float> generateNoise(const double sampleRate)
+    {
+        std::vector<float> samples((size_t) (0.25 * sampleRate));
+        juce::Random random(0x9001);
+
+        for (auto& sample : samples)
+            sample = 0.5f * (random.nextFloat() * 2.f - 1.f);
+
+        return samples;
+    }
+
+    // Karplus-Strong plucks of the bottom four strings, each left ringing
+    // under the next, about as hot as a DI'd guitar
+    std::vector<float> generateGuitar(const double sampleRate)
+    {
+        const auto numSamples = (int) (0.75 * sampleRate);
+        const double noteFreqs[] = { 82.41, 110.0, 146.83, 196.0 };
+        const auto noteSpacing = numSamples / (int) std::size(noteFreqs);
+
+        std::vector<float> samples((size_t) numSamples, 0.f);
+        juce::Random random(0x6172);
+
+        for (size_t note = 0; note < std::size(noteFreqs); ++note)
+        {
+            std::vector<float> string((size_t) juce::roundToInt(sampleRate / noteFreqs[note]));
+
+            for (auto& sample : string)
+                sample = random.nextFloat() * 2.f - 1.f;
+
+            size_t position = 0;
+
+            for (auto i = (int) note * noteSpacing; i < numSamples; ++i)
+            {
+                auto next = (position + 1) % string.size();
+
+                samples[(size_t) i] += 0.2f * string[position];
+                string[position] = 0.498f * (string[position] + string[next]);
+                position = next;
+            }
+        }
+
+        return samples;
+    }
+}
+
+// =============================================================================
+const char* getName(Signal signal)
+{
+    switch (signal)
+    {
+        case Signal::sweep:     return "sweep";
+        case Signal::noise:     return "noise";
+        case Signal::guitar:    return "guitar";
+    }
+
+    return "";
+}
+
+std::vector<float> generate(Signal signal, const double sampleRate)
+{
+    switch (signal)
+    {
+        case Signal::sweep:     return generateSweep(sampleRate);
+        case Signal::noise:     return generateNoise(sampleRate);
+        case Signal::guitar:    return generateGuitar(sampleRate);
+    }
+
+    return {};
+}
+}
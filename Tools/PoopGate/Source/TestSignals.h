@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    TestSignals.h
+    Created: 20 Oct 2026 9:14:52am
+    Author:  bob
+
+    The fixed inputs the gate renders. Everything is generated from fixed
+    seeds, so the same build renders the same samples on every machine and
+    there are no input files to keep next to the golden ones.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace TestSignals
+{
+    enum class Signal
+    {
+        sweep,          // exponential sine sweep, 20 Hz - 20 kHz
+        noise,          // white noise
+        guitar          // plucked strings, a stand-in for a DI recording
+    };
+
+    constexpr Signal allSignals[] = { Signal::sweep, Signal::noise, Signal::guitar };
+
+    const char* getName(Signal signal);
+
+    std::vector<float> generate(Signal signal, const double sampleRate);
+}
@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 11:02:38pm
+    Author:  bob
+
+    Tone matcher. Renders a DI recording through a grid of Drive, Tone and
+    Level settings, ranks every candidate by how far its spectrum is from a
+    reference recording's, then narrows the grid in around the best one and
+    goes again.
+
+    PoopMatch --input DI.wav --target reference.wav
+              [--drive A:B:STEP] [--tone A:B:STEP] [--level A:B:STEP]
+              [--refine N] [--threads N] [--batch N] [--top N]
+
+    Each axis defaults to 0:10:1, a single value pins it. --refine rounds
+    (2 by default) each halve the step around the best match so far.
+    Every candidate in a round shares one pass over the input, unless
+    --batch caps how many do when memory is short.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SpectralProfile.h"
+#include "SweepRenderer.h"
+
+namespace
+{
+    // =============================================================================
+    // One knob's values, start to end inclusive
+    struct Axis
+    {
+        float start = 0.f, end = 10.f, step = 1.f;
+
+        static Axis parse(const juce::String& text)
+        {
+            Axis axis;
+
+            if (text.isEmpty())
+                return axis;
+
+            auto values = juce::StringArray::fromTokens(text, ":", "");
+            axis.start = juce::jlimit(0.f, 10.f, values[0].getFloatValue());
+            axis.end = values.size() > 1 ? juce::jlimit(axis.start, 10.f, values[1].getFloatValue()) : axis.start;
+            axis.step = values.size() > 2 ? juce::jmax(0.01f, values[2].getFloatValue()) : 1.f;
+
+            return axis;
+        }
+
+        std::vector<float> getValues() const
+        {
+            std::vector<float> values;
+
+            for (int i = 0; start + (float) i * step <= end + 1.0e-4f; ++i)
+                values.push_back(start + (float) i * step);
+
+            return values;
+        }
+    };
+
+    struct Candidate
+    {
+        ChainSettings settings;
+        float distance = 0.f;
+    };
+
+    ChainSettings makeSettings(float drive, float tone, float level)
+    {
+        ChainSettings settings;
+        settings.quality = QualityTier::high;
+        settings.drive = drive;
+        settings.tone = tone;
+        settings.level = level;
+
+        return settings;
+    }
+
+    std::vector<ChainSettings> makeGrid(const Axis& drive, const Axis& tone, const Axis& level)
+    {
+        std::vector<ChainSettings> grid;
+
+        for (auto driveValue : drive.getValues())
+            for (auto toneValue : tone.getValues())
+                for (auto levelValue : level.getValues())
+                    grid.push_back(makeSettings(driveValue, toneValue, levelValue));
+
+        return grid;
+    }
+
+    // The neighbours of the best match so far, a step either side on every
+    // axis that isn't pinned, leaving out anything already rendered
+    std::vector<ChainSettings> makeRefinement(const ChainSettings& best,
+                                                const std::array<float, 3>& steps,
+                                                const std::vector<Candidate>& scored)
+    {
+        std::vector<ChainSettings> refinement;
+
+        auto getValues = [] (float centre, float step)
+        {
+            if (step <= 0.f)
+                return std::vector<float> { centre };
+
+            return std::vector<float> { juce::jmax(0.f, centre - step), centre, juce::jmin(10.f, centre + step) };
+        };
+
+        for (auto drive : getValues(best.drive, steps[0]))
+            for (auto tone : getValues(best.tone, steps[1]))
+                for (auto level : getValues(best.level, steps[2]))
+                {
+                    auto settings = makeSettings(drive, tone, level);
+
+                    auto isScored = std::any_of(scored.begin(), scored.end(),
+                                                [&settings] (const Candidate& c) { return c.settings == settings; });
+                    auto isQueued = std::find(refinement.begin(), refinement.end(), settings) != refinement.end();
+
+                    if (! isScored && ! isQueued)
+                        refinement.push_back(settings);
+                }
+
+        return refinement;
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> openReader(juce::AudioFormatManager& formatManager,
+                                                        const juce::String& path)
+    {
+        juce::File file(juce::File::getCurrentWorkingDirectory().getChildFile(path));
+
+        if (! file.existsAsFile())
+        {
+            std::cerr << "PoopMatch: can't find " << file.getFullPathName() << std::endl;
+            return {};
+        }
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if (reader == nullptr)
+            std::cerr << "PoopMatch: can't read " << file.getFullPathName() << std::endl;
+
+        return reader;
+    }
+}
+
+// =============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    auto driveAxis = Axis::parse(args.getValueForOption("--drive"));
+    auto toneAxis = Axis::parse(args.getValueForOption("--tone"));
+    auto levelAxis = Axis::parse(args.getValueForOption("--level"));
+    auto numRefinements = args.getValueForOption("--refine").getIntValue();
+    auto numThreads = args.getValueForOption("--threads").getIntValue();
+    auto batchSize = args.getValueForOption("--batch").getIntValue();
+    auto numTop = args.getValueForOption("--top").getIntValue();
+
+    if (! args.containsOption("--refine"))  numRefinements = 2;
+    if (numThreads <= 0)                    numThreads = juce::SystemStats::getNumCpus();
+    if (numTop <= 0)                        numTop = 10;
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto input = openReader(formatManager, args.getValueForOption("--input"));
+    auto target = openReader(formatManager, args.getValueForOption("--target"));
+
+    if (input == nullptr || target == nullptr)
+        return 1;
+
+    if (input->sampleRate != target->sampleRate)
+    {
+        std::cerr << "PoopMatch: the input and target need the same sample rate" << std::endl;
+        return 1;
+    }
+
+    SpectralAnalyser analyser(input->sampleRate);
+    auto targetLevels = SweepRenderer::analyse(*target, analyser);
+
+    SweepRenderer renderer(*input, numThreads, batchSize);
+    std::vector<Candidate> scored;
+
+    auto renderAndScore = [&] (const std::vector<ChainSettings>& candidates)
+    {
+        auto results = renderer.render(candidates, analyser);
+
+        for (size_t i = 0; i < candidates.size(); ++i)
+            scored.push_back({ candidates[i], SpectralAnalyser::getDistance(results[i], targetLevels) });
+
+        std::sort(scored.begin(), scored.end(), [] (const Candidate& a, const Candidate& b)
+        {
+            return a.distance < b.distance;
+        });
+    };
+
+    std::cout << "PoopMatch: " << input->lengthInSamples / input->sampleRate << " s at "
+              << input->sampleRate << " Hz, " << numThreads << " threads" << std::endl;
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    // The grid, then narrower and narrower around the best match
+    auto grid = makeGrid(driveAxis, toneAxis, levelAxis);
+    renderAndScore(grid);
+
+    std::cout << "grid: " << (int) grid.size() << " candidates, best " << scored.front().distance << " dB" << std::endl;
+
+    std::array<float, 3> steps { driveAxis.end > driveAxis.start ? driveAxis.step : 0.f,
+                                 toneAxis.end > toneAxis.start ? toneAxis.step : 0.f,
+                                 levelAxis.end > levelAxis.start ? levelAxis.step : 0.f };
+
+    for (int round = 1; round <= numRefinements; ++round)
+    {
+        for (auto& step : steps)
+            step *= 0.5f;
+
+        auto refinement = makeRefinement(scored.front().settings, steps, scored);
+
+        if (refinement.empty())
+            break;
+
+        renderAndScore(refinement);
+
+        std::cout << "refinement " << round << ": " << (int) refinement.size()
+                  << " candidates, best " << scored.front().distance << " dB" << std::endl;
+    }
+
+    auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    auto renderedSeconds = (double) scored.size() * (double) input->lengthInSamples / input->sampleRate;
+
+    std::cout << (int) scored.size() << " candidates in " << juce::String(seconds, 1) << " s, "
+              << juce::String(renderedSeconds / seconds, 1) << "x real time" << std::endl << std::endl;
+
+    // =============================================================================
+    std::cout << juce::String("drive").paddedLeft(' ', 8)
+              << juce::String("tone").paddedLeft(' ', 8)
+              << juce::String("level").paddedLeft(' ', 8)
+              << juce::String("distance (dB)").paddedLeft(' ', 16) << std::endl;
+
+    for (int i = 0; i < juce::jmin(numTop, (int) scored.size()); ++i)
+    {
+        auto& candidate = scored[(size_t) i];
+
+        std::cout << juce::String(candidate.settings.drive, 2).paddedLeft(' ', 8)
+                  << juce::String(candidate.settings.tone, 2).paddedLeft(' ', 8)
+                  << juce::String(candidate.settings.level, 2).paddedLeft(' ', 8)
+                  << juce::String(candidate.distance, 2).paddedLeft(' ', 16) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    SpectralProfile.cpp
+    Created: 19 Oct 2026 11:02:38pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "SpectralProfile.h"
+
+// =============================================================================
+SpectralAnalyser::SpectralAnalyser(const double sampleRate)
+{
+    // periodic Hann, so overlapping frames by half adds up flat
+    window.resize((size_t) fftSize);
+
+    for (int i = 0; i < fftSize; ++i)
+        window[(size_t) i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float) i / (float) fftSize);
+
+    // Third octave bands from 50 Hz to 16 kHz, or a bit short of Nyquist.
+    // Below that there's hardly a bin per band, above it the guitar is gone.
+    const auto binHz = sampleRate / fftSize;
+    const auto topHz = juce::jmin(16000.0, 0.45 * sampleRate);
+
+    for (auto lowHz = 50.0; lowHz < topHz; lowHz *= std::pow(2.0, 1.0 / 3.0))
+    {
+        auto highHz = juce::jmin(topHz, lowHz * std::pow(2.0, 1.0 / 3.0));
+        auto firstBin = (int) std::ceil(lowHz / binHz);
+        auto lastBin = (int) std::ceil(highHz / binHz) - 1;
+
+        if (lastBin >= firstBin)
+            bands.push_back({ firstBin, lastBin });
+    }
+}
+
+std::vector<float> SpectralAnalyser::getBandLevels(const std::vector<double>& bandPower, const int numFrames) const
+{
+    std::vector<float> levels(bands.size());
+
+    for (size_t band = 0; band < bands.size(); ++band)
+    {
+        auto numBins = bands[band].lastBin - bands[band].firstBin + 1;
+        auto meanPower = bandPower[band] / juce::jmax(1, numFrames * numBins);
+
+        // floor well below anything the engine puts out
+        levels[band] = (float) (10.0 * std::log10(meanPower + 1.0e-20));
+    }
+
+    return levels;
+}
+
+float SpectralAnalyser::getDistance(const std::vector<float>& levels, const std::vector<float>& targetLevels)
+{
+    jassert(levels.size() == targetLevels.size());
+
+    double sumSquares = 0.0;
+
+    for (size_t band = 0; band < levels.size(); ++band)
+    {
+        auto difference = (double) levels[band] - (double) targetLevels[band];
+        sumSquares += difference * difference;
+    }
+
+    return (float) std::sqrt(sumSquares / (double) juce::jmax((size_t) 1, levels.size()));
+}
+
+// =============================================================================
+SpectralProfile::SpectralProfile(const SpectralAnalyser& spectralAnalyser)
+    : analyser(spectralAnalyser),
+      history((size_t) SpectralAnalyser::fftSize, 0.f),
+      frame((size_t) SpectralAnalyser::fftSize * 2, 0.f),
+      bandPower((size_t) spectralAnalyser.getNumBands(), 0.0)
+{}
+
+void SpectralProfile::addHop(const float* samples)
+{
+    constexpr auto hopSize = SpectralAnalyser::hopSize;
+
+    // slide the newest hop in behind the previous one
+    std::copy(history.begin() + hopSize, history.end(), history.begin());
+    std::copy(samples, samples + hopSize, history.begin() + hopSize);
+
+    if (++numHops < 2)
+        return;
+
+    for (size_t i = 0; i < history.size(); ++i)
+        frame[i] = history[i] * analyser.window[i];
+
+    analyser.fft.performFrequencyOnlyForwardTransform(frame.data());
+
+    for (size_t band = 0; band < analyser.bands.size(); ++band)
+    {
+        double power = 0.0;
+
+        for (auto bin = analyser.bands[band].firstBin; bin <= analyser.bands[band].lastBin; ++bin)
+            power += (double) frame[(size_t) bin] * (double) frame[(size_t) bin];
+
+        bandPower[band] += power;
+    }
+}
+
+std::vector<float> SpectralProfile::getBandLevels() const
+{
+    return analyser.getBandLevels(bandPower, juce::jmax(0, numHops - 1));
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    SpectralProfile.h
+    Created: 19 Oct 2026 11:02:38pm
+    Author:  bob
+
+    Long-term average spectrum of a signal, fed a hop at a time, in third
+    octave bands. Two of them compare by the RMS of their dB difference. It
+    doesn't care where in time anything happens, so the engine's latency
+    and small offsets between the recordings don't count against a match.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The FFT, window and band layout for one sample rate. Read only once built,
+// so every profile shares one.
+class SpectralAnalyser
+{
+public:
+    // =============================================================================
+    static constexpr int fftOrder = 13;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;
+
+    explicit SpectralAnalyser(const double sampleRate);
+
+    int getNumBands() const { return (int) bands.size(); }
+
+    // Band levels in dB from per band power summed over numFrames frames
+    std::vector<float> getBandLevels(const std::vector<double>& bandPower, const int numFrames) const;
+
+    // RMS of the difference between two sets of band levels, in dB
+    static float getDistance(const std::vector<float>& levels, const std::vector<float>& targetLevels);
+
+private:
+    //==============================================================================
+    friend class SpectralProfile;
+
+    struct Band
+    {
+        int firstBin, lastBin;      // inclusive
+    };
+
+    juce::dsp::FFT fft { fftOrder };
+    std::vector<float> window;
+    std::vector<Band> bands;
+
+    JUCE_DECLARE_NON_COPYABLE(SpectralAnalyser)
+};
+
+// One signal's running spectrum
+class SpectralProfile
+{
+public:
+    // =============================================================================
+    explicit SpectralProfile(const SpectralAnalyser& analyser);
+
+    // Exactly hopSize samples. Frames overlap by half, the first one is
+    // complete after the second hop.
+    void addHop(const float* samples);
+
+    std::vector<float> getBandLevels() const;
+
+private:
+    //==============================================================================
+    const SpectralAnalyser& analyser;
+
+    std::vector<float> history;         // the last fftSize samples
+    std::vector<float> frame;           // FFT scratch, twice fftSize
+    std::vector<double> bandPower;
+    int numHops = 0;
+};
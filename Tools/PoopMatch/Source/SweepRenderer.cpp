@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    SweepRenderer.cpp
+    Created: 19 Oct 2026 11:02:38pm
+    Author:  bob
+
+  ==============================================================================
+*/
+
+#include "SweepRenderer.h"
+
+// =============================================================================
+SweepRenderer::SweepRenderer(juce::AudioFormatReader& inputReader, const int numThreads, const int batchSize)
+    : reader(inputReader),
+      maxBatchSize(batchSize),
+      inputHop((size_t) SpectralAnalyser::hopSize, 0.f)
+{
+    // A sweep can run for hours, so the workers get JUCE's default priority
+    // rather than the audio one
+    workerPool.start(juce::jmax(0, numThreads - 1), 5);
+}
+
+SweepRenderer::~SweepRenderer()
+{
+    workerPool.stop();
+}
+
+SweepRenderer::Voice::Voice(const SpectralAnalyser& analyser, const ChainSettings& candidateSettings)
+    : settings(candidateSettings),
+      buffer(1, SpectralAnalyser::hopSize),
+      profile(analyser)
+{
+    // offline, so prepare() builds everything before it returns
+    engine.setNonRealtime(true);
+}
+
+// =============================================================================
+std::vector<std::vector<float>> SweepRenderer::render(const std::vector<ChainSettings>& candidates,
+                                                        const SpectralAnalyser& analyser)
+{
+    std::vector<std::vector<float>> results;
+    results.reserve(candidates.size());
+
+    const auto batchSize = maxBatchSize > 0 ? (size_t) maxBatchSize : candidates.size();
+
+    for (size_t first = 0; first < candidates.size(); first += batchSize)
+    {
+        auto last = juce::jmin(candidates.size(), first + batchSize);
+
+        std::vector<std::unique_ptr<Voice>> voices;
+        voices.reserve(last - first);
+
+        for (auto i = first; i < last; ++i)
+            voices.push_back(std::make_unique<Voice>(analyser, candidates[i]));
+
+        renderBatch(voices);
+
+        for (auto& voice : voices)
+            results.push_back(voice->profile.getBandLevels());
+    }
+
+    return results;
+}
+
+void SweepRenderer::renderBatch(std::vector<std::unique_ptr<Voice>>& voices)
+{
+    currentVoices = &voices;
+
+    const auto numTasks = ((int) voices.size() + voicesPerTask - 1) / voicesPerTask;
+
+    // the engines build their oversamplers and state in parallel too
+    workerPool.run(prepareVoices, this, numTasks);
+
+    // One pass over the input for the whole batch
+    juce::AudioBuffer<float> scratch((int) reader.numChannels, SpectralAnalyser::hopSize);
+
+    for (juce::int64 position = 0; position < reader.lengthInSamples; position += SpectralAnalyser::hopSize)
+    {
+        readMonoHop(reader, scratch, inputHop.data(), position);
+        workerPool.run(processVoices, this, numTasks);
+    }
+
+    currentVoices = nullptr;
+}
+
+void SweepRenderer::prepareVoices(void* context, int taskIndex)
+{
+    auto& renderer = *static_cast<SweepRenderer*>(context);
+    auto& voices = *renderer.currentVoices;
+
+    auto first = (size_t) taskIndex * voicesPerTask;
+    auto last = juce::jmin(voices.size(), first + voicesPerTask);
+
+    for (auto i = first; i < last; ++i)
+    {
+        auto& voice = *voices[i];
+
+        voice.engine.prepare({ renderer.reader.sampleRate, (juce::uint32) SpectralAnalyser::hopSize, 1 },
+                                renderer.reader.sampleRate,
+                                voice.settings);
+    }
+}
+
+void SweepRenderer::processVoices(void* context, int taskIndex)
+{
+    auto& renderer = *static_cast<SweepRenderer*>(context);
+    auto& voices = *renderer.currentVoices;
+
+    auto first = (size_t) taskIndex * voicesPerTask;
+    auto last = juce::jmin(voices.size(), first + voicesPerTask);
+
+    for (auto i = first; i < last; ++i)
+    {
+        auto& voice = *voices[i];
+        auto* samples = voice.buffer.getWritePointer(0);
+
+        std::copy(renderer.inputHop.begin(), renderer.inputHop.end(), samples);
+
+        voice.engine.process(voice.buffer, renderer.reader.sampleRate, voice.settings);
+        voice.profile.addHop(samples);
+    }
+}
+
+// =============================================================================
+std::vector<float> SweepRenderer::analyse(juce::AudioFormatReader& fileReader, const SpectralAnalyser& analyser)
+{
+    SpectralProfile profile(analyser);
+
+    juce::AudioBuffer<float> scratch((int) fileReader.numChannels, SpectralAnalyser::hopSize);
+    std::vector<float> hop((size_t) SpectralAnalyser::hopSize);
+
+    for (juce::int64 position = 0; position < fileReader.lengthInSamples; position += SpectralAnalyser::hopSize)
+    {
+        readMonoHop(fileReader, scratch, hop.data(), position);
+        profile.addHop(hop.data());
+    }
+
+    return profile.getBandLevels();
+}
+
+void SweepRenderer::readMonoHop(juce::AudioFormatReader& fileReader,
+                                juce::AudioBuffer<float>& scratch,
+                                float* destination,
+                                const juce::int64 position)
+{
+    constexpr auto hopSize = SpectralAnalyser::hopSize;
+
+    // the reader zero fills whatever is past the end of the file
+    fileReader.read(&scratch, 0, hopSize, position, true, true);
+
+    const auto numChannels = scratch.getNumChannels();
+    std::fill(destination, destination + hopSize, 0.f);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* source = scratch.getReadPointer(channel);
+
+        for (int i = 0; i < hopSize; ++i)
+            destination[i] += source[i] / (float) numChannels;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    SweepRenderer.h
+    Created: 19 Oct 2026 11:02:38pm
+    Author:  bob
+
+    Renders one input through a whole batch of settings at once. Each block
+    of the input is read once and fanned out to one engine per candidate,
+    the candidates split across the worker pool, and every candidate's output
+    goes straight into its spectral profile rather than into a file.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SpectralProfile.h"
+#include "../../../Source/ShitClipper.h"
+#include "../../../Source/ShitWorkerPool.h"
+
+class SweepRenderer
+{
+public:
+    // =============================================================================
+    // numThreads counts the calling thread. A maxBatchSize of 0 or less puts
+    // every candidate in one batch.
+    SweepRenderer(juce::AudioFormatReader& inputReader, const int numThreads, const int maxBatchSize);
+    ~SweepRenderer();
+
+    // Band levels of the input rendered through each of the candidates, in
+    // the same order. Runs one pass over the input, or as many as it takes
+    // to get through them maxBatchSize at a time.
+    std::vector<std::vector<float>> render(const std::vector<ChainSettings>& candidates,
+                                            const SpectralAnalyser& analyser);
+
+    // The spectrum of a file as it is, e.g. the target
+    static std::vector<float> analyse(juce::AudioFormatReader& fileReader, const SpectralAnalyser& analyser);
+
+    // Reads a hop at position, mixed down to mono, zero padded past the end
+    static void readMonoHop(juce::AudioFormatReader& fileReader,
+                            juce::AudioBuffer<float>& scratch,
+                            float* destination,
+                            const juce::int64 position);
+
+private:
+    //==============================================================================
+    struct Voice
+    {
+        Voice(const SpectralAnalyser& analyser, const ChainSettings& candidateSettings);
+
+        ShitClipper engine;
+        ChainSettings settings;
+        juce::AudioBuffer<float> buffer;
+        SpectralProfile profile;
+    };
+
+    void renderBatch(std::vector<std::unique_ptr<Voice>>& voices);
+
+    static void prepareVoices(void* context, int taskIndex);
+    static void processVoices(void* context, int taskIndex);
+
+    juce::AudioFormatReader& reader;
+    ShitWorkerPool workerPool;
+    int maxBatchSize;
+
+    // Shared with the tasks for the block in flight
+    std::vector<std::unique_ptr<Voice>>* currentVoices = nullptr;
+    std::vector<float> inputHop;
+
+    // Candidates per task. Small enough to keep every core busy to the end
+    // of a block, big enough that claiming tasks costs nothing.
+    static constexpr int voicesPerTask = 4;
+
+    JUCE_DECLARE_NON_COPYABLE(SweepRenderer)
+};